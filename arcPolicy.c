@@ -0,0 +1,235 @@
+// arcPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains adaptive replacement cache (ARC) page replacement, as
+// described by Megiddo and Modha. Resident pages referenced once since they
+// were loaded are kept in T1 and pages referenced again in T2. B1 and B2
+// remember the keys of pages recently evicted from each. A fault on a page
+// remembered in B1 grows the target size of T1, and one in B2 shrinks it.
+
+#include "constants.h"
+#include "indexList.h"
+#include "pageMap.h"
+#include "replacementPolicy.h"
+
+// Ids of the lists an entry can be in
+enum ListId {T1, T2, B1, B2, UNUSED, NUM_LISTS};
+
+// Prototypes
+static void arcInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace);
+static void arcAllocate(int frameNum, PageKey key);
+static void arcReference(int frameNum, PageKey key);
+static int arcEvict(PageKey key);
+static void arcFree(int frameNum);
+static void adapt(PageKey key);
+static void forgetFront(IndexList * list);
+static int replace(PageKey key);
+static int directorySize();
+static int max(int a, int b);
+static int min(int a, int b);
+
+const ReplacementPolicy ARC_POLICY = {
+	"arc", arcInit, arcAllocate, arcReference, arcEvict, arcFree, false
+};
+
+// Static global variables
+static IndexPool pool;			// Links between entries
+static IndexList lists[NUM_LISTS];	// Lists of entries, indexed by id
+static PageKey * keys;			// Key of the page of each entry
+static int * entryFrame;		// Frame of each resident entry
+static int * frameEntry;		// Entry of each allocated frame
+static PageMap entries;			// Entry of each remembered key
+static int capacity;			// Number of frames
+static int target;			// Target number of pages in T1
+static PageKey adaptedKey;		// Key of a fault already adapted to
+
+// Starts with every list empty and every entry unused
+static void arcInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace){
+	int i;
+
+	capacity = numFrames;
+	target = 0;
+	adaptedKey = EMPTY;
+
+	// Allocates an entry for each frame and each remembered key
+	initIndexPool(&pool, 2 * capacity);
+	keys = policyAlloc(sizeof(PageKey) * 2 * capacity);
+	entryFrame = policyAlloc(sizeof(int) * 2 * capacity);
+	frameEntry = policyAlloc(sizeof(int) * capacity);
+	initPageMap(&entries, 2 * capacity);
+
+	for (i = 0; i < NUM_LISTS; i++)
+		initIndexList(&lists[i], i);
+
+	for (i = 0; i < 2 * capacity; i++){
+		entryFrame[i] = EMPTY;
+		pushBack(&lists[UNUSED], &pool, i);
+	}
+
+	for (i = 0; i < capacity; i++)
+		frameEntry[i] = EMPTY;
+}
+
+// Adds the page to T2 if it was remembered or T1 if it is new
+static void arcAllocate(int frameNum, PageKey key){
+	int entry;
+
+	// Adapts to a fault on a remembered key if arcEvict did not
+	if (adaptedKey != key){
+		adapt(key);
+
+		// Keeps the directory within its bounds for a new key
+		if (pageMapGet(&entries, key) == EMPTY){
+			if (lists[T1].count + lists[B1].count >= capacity
+			    && lists[B1].count > 0)
+				forgetFront(&lists[B1]);
+			else if (directorySize() >= 2 * capacity
+				 && lists[B2].count > 0)
+				forgetFront(&lists[B2]);
+		}
+	}
+	adaptedKey = EMPTY;
+
+	// Moves a remembered key to T2
+	if ((entry = pageMapGet(&entries, key)) != EMPTY){
+		removeIndex(&lists[pool.list[entry]], &pool, entry);
+		pushBack(&lists[T2], &pool, entry);
+	}
+
+	// Adds a new key to T1
+	else {
+		entry = popFront(&lists[UNUSED], &pool);
+		keys[entry] = key;
+		pageMapPut(&entries, key, entry);
+		pushBack(&lists[T1], &pool, entry);
+	}
+
+	entryFrame[entry] = frameNum;
+	frameEntry[frameNum] = entry;
+}
+
+// Moves a referenced resident page to the most recently used end of T2
+static void arcReference(int frameNum, PageKey key){
+	int entry;
+
+	if (frameNum == EMPTY) return;
+
+	entry = frameEntry[frameNum];
+	removeIndex(&lists[pool.list[entry]], &pool, entry);
+	pushBack(&lists[T2], &pool, entry);
+}
+
+// Returns a frame to evict, remembering its key in B1 or B2
+static int arcEvict(PageKey key){
+	int entry;
+	int frameNum;
+
+	adapt(key);
+	adaptedKey = key;
+
+	// Keeps the directory within its bounds for a new key
+	if (pageMapGet(&entries, key) == EMPTY){
+		if (lists[T1].count + lists[B1].count >= capacity){
+
+			// Forgets the oldest key in B1 if there is room in T1
+			if (lists[T1].count < capacity)
+				forgetFront(&lists[B1]);
+
+			// Evicts the front of T1 without remembering it
+			else {
+				entry = popFront(&lists[T1], &pool);
+				frameNum = entryFrame[entry];
+
+				pageMapRemove(&entries, keys[entry]);
+				entryFrame[entry] = EMPTY;
+				frameEntry[frameNum] = EMPTY;
+				pushBack(&lists[UNUSED], &pool, entry);
+
+				return frameNum;
+			}
+		}
+		else if (directorySize() >= 2 * capacity)
+			forgetFront(&lists[B2]);
+	}
+
+	return replace(key);
+}
+
+// Forgets a resident page freed by a terminating process
+static void arcFree(int frameNum){
+	int entry = frameEntry[frameNum];
+
+	removeIndex(&lists[pool.list[entry]], &pool, entry);
+	pageMapRemove(&entries, keys[entry]);
+	entryFrame[entry] = EMPTY;
+	frameEntry[frameNum] = EMPTY;
+	pushBack(&lists[UNUSED], &pool, entry);
+}
+
+// Adjusts the target size of T1 after a fault on a key in B1 or B2
+static void adapt(PageKey key){
+	int entry = pageMapGet(&entries, key);
+
+	if (entry == EMPTY) return;
+
+	if (pool.list[entry] == B1)
+		target = min(capacity, target
+			     + max(lists[B2].count / lists[B1].count, 1));
+	else if (pool.list[entry] == B2)
+		target = max(0, target
+			     - max(lists[B1].count / lists[B2].count, 1));
+}
+
+// Forgets the oldest key in a list of evicted pages
+static void forgetFront(IndexList * list){
+	int entry = popFront(list, &pool);
+
+	pageMapRemove(&entries, keys[entry]);
+	pushBack(&lists[UNUSED], &pool, entry);
+}
+
+// Evicts the front of T1 or T2, depending on the target, and remembers it
+static int replace(PageKey key){
+	int entry;
+	int frameNum;
+	int inB2;
+
+	entry = pageMapGet(&entries, key);
+	inB2 = entry != EMPTY && pool.list[entry] == B2;
+
+	// Moves the front of T1 to B1 if T1 exceeds its target
+	if (lists[T1].count > 0 && (lists[T1].count > target
+	    || (inB2 && lists[T1].count == target) || lists[T2].count == 0)){
+		entry = popFront(&lists[T1], &pool);
+		pushBack(&lists[B1], &pool, entry);
+	}
+
+	// Moves the front of T2 to B2 otherwise
+	else {
+		entry = popFront(&lists[T2], &pool);
+		pushBack(&lists[B2], &pool, entry);
+	}
+
+	frameNum = entryFrame[entry];
+	entryFrame[entry] = EMPTY;
+	frameEntry[frameNum] = EMPTY;
+
+	return frameNum;
+}
+
+// Returns the number of resident and remembered pages
+static int directorySize(){
+	return lists[T1].count + lists[T2].count + lists[B1].count
+	       + lists[B2].count;
+}
+
+// Returns the larger of two ints
+static int max(int a, int b){
+	return a > b ? a : b;
+}
+
+// Returns the smaller of two ints
+static int min(int a, int b){
+	return a < b ? a : b;
+}
@@ -1,14 +0,0 @@
-// bitVector.h was created by Mark Renard on 3/29/2020
-//
-// This file contains headers of functions defined in bitVector.c.
-
-void initializeBitVector();
-
-unsigned int isReservedInBitVector(int num);
-
-void reserveInBitVector(int num);
-
-void freeInBitVector(int num);
-
-int getIntFromBitVector();
-
@@ -1,161 +1,70 @@
 // clock.c was created by Mark Renard on 2/21/2020
 //
-// This file contains an implementation of the function incrementClock which
-// adds some number of nanoseconds to the time recorded in a virtual clock.
+// This file contains functions for simulated times, which are counts of
+// nanoseconds. Arithmetic on times is done with the ordinary operators, so
+// these functions only draw random times and split times for printing.
 
 #include "clock.h"
 #include "randomGen.h"
 #include <stdio.h>
 
-#define BILLION 1000000000
 #define FORMAT "%03d : %09d"
 #define FORMAT_LN "%03d : %09d\n"
 
-// Returns a clock initialized to zero seconds, zero nanoseconds
-Clock zeroClock(){
-	Clock clock = {0, 0};
-	return clock;
-}
-
-// Returns a clock with passed values of seconds and nanoseconds
-Clock newClock(unsigned int seconds, unsigned int nanoseconds){
-	Clock clock = {seconds, nanoseconds};
-	return clock;
-}
-
-// Returns a clock with a randomly selected time in the specified range
-Clock randomTime(const Clock min, const Clock max){
-	Clock rTime; // The random time to be returned
+// Returns a randomly selected time in the specified range, drawing seconds
+// and then nanoseconds so that seeded runs repeat earlier versions
+Time randomTime(Time min, Time max){
+	unsigned int minSec = timeSeconds(min);	// Seconds part of min
+	unsigned int maxSec = timeSeconds(max);	// Seconds part of max
+	unsigned int seconds;			// Seconds of the random time
+	unsigned int nanoseconds;		// Nanoseconds of the random time
 
 	// Sets the number of seconds
-	rTime.seconds = min.seconds == max.seconds ? \
-		min.seconds : randUnsigned(min.seconds, max.seconds);
+	seconds = minSec == maxSec ? minSec : randUnsigned(minSec, maxSec);
 
 	// Sets nanoseconds in the case where min and max seconds is equal
-	if (min.seconds == max.seconds){
-		rTime.nanoseconds = randUnsigned(
-					min.nanoseconds, max.nanoseconds
-				    );
+	if (minSec == maxSec){
+		nanoseconds = randUnsigned(timeNanoseconds(min),
+					   timeNanoseconds(max));
 
 	// Sets nanoseconds if the minimum number of seconds was selected
-	} else if (rTime.seconds == min.seconds){
-		rTime.nanoseconds = randUnsigned(min.nanoseconds, BILLION - 1);
+	} else if (seconds == minSec){
+		nanoseconds = randUnsigned(timeNanoseconds(min),
+					   NS_PER_SECOND - 1);
 
 	// Sets nanoseconds if the maximum number of seconds was selected
-	} else if (rTime.seconds == max.seconds){
-		rTime.nanoseconds = randUnsigned(0, max.nanoseconds);
+	} else if (seconds == maxSec){
+		nanoseconds = randUnsigned(0, timeNanoseconds(max));
 
 	// Sets nanoseconds to [0, 999999999] otherwise
 	} else {
-		rTime.nanoseconds = randUnsigned(0, BILLION - 1);
+		nanoseconds = randUnsigned(0, NS_PER_SECOND - 1);
 	}
 
-	return rTime;
-}
-
-// Copies the time stored in the second clock to the first
-void copyTime(Clock * dest, const Clock src){
-	dest->seconds = src.seconds;
-	dest->nanoseconds = src.nanoseconds;
-}
-
-// Performs carry operations on a time
-static void carry(Clock * clock){
-        clock->seconds += clock->nanoseconds / BILLION;
-        clock->nanoseconds = clock->nanoseconds % BILLION;
-
-}
-
-// Adds a time increment defined in a clock structure to a clock
-void incrementClock(Clock * clock, const Clock increment){	
-	clock->seconds += increment.seconds;
-	clock->nanoseconds += increment.nanoseconds;
-
-	carry(clock);
+	return TIME(seconds, nanoseconds);
 }
 
-
-// Returns -1 if the time on clk1 is less, 1 if it's greater, and 0 if equal
-int clockCompare(const Clock clk1, const Clock clk2){
-	if (clk1.seconds != clk2.seconds){
-		// Compares seconds if they are not equal
-		if (clk1.seconds < clk2.seconds) return -1;
-		if (clk1.seconds > clk2.seconds) return 1;
-	} else {
-		// Compares nanoseconds if seconds are equal
-		if (clk1.nanoseconds < clk2.nanoseconds) return -1;
-		if (clk1.nanoseconds > clk2.nanoseconds) return 1;
-	}
-
-	// If this statement executes, the two times are equal.
-	return 0;
+// Returns the whole seconds of a time
+unsigned int timeSeconds(Time t){
+	return t / NS_PER_SECOND;
 }
 
-// Returns the sum of two times
-Clock clockSum(Clock t1, Clock t2){
-	incrementClock(&t1, t2);
-	return t1;
-}
-
-// Returns the difference of two times (t1 - t2)
-Clock clockDiff(Clock t1, Clock t2){
-
-	// Performs borrowing if necessary
-	if (t1.nanoseconds < t2.nanoseconds){
-		t1.nanoseconds += BILLION;
-		t1.seconds -= 1;
-	}
-
-	t1.seconds -= t2.seconds;
-	t1.nanoseconds -= t2.nanoseconds;
-
-	return t1;
-}
-
-// Returns the ratio of two times (t1 / t2)
-long double clockRatio(Clock t1, Clock t2){
-	unsigned long long int t1TotalNano;
-	unsigned long long int t2TotalNano;
-
-	t1TotalNano = (unsigned long long)t1.seconds * BILLION + t1.nanoseconds;
-	t2TotalNano = (unsigned long long)t2.seconds * BILLION + t2.nanoseconds;
-
-	return (long double)t1TotalNano / (long double)t2TotalNano;
-}
-
-// Returns a time divided by an integer
-Clock clockDiv(Clock t, unsigned int n){
-	Clock q;
-
-	q.seconds = t.seconds / n;
-	q.nanoseconds = (BILLION * t.seconds % n) / n;
-	q.nanoseconds += t.nanoseconds / n;
-
-	carry(&q);
-
-	return q;		
+// Returns the nanoseconds of a time past its whole seconds
+unsigned int timeNanoseconds(Time t){
+	return t % NS_PER_SECOND;
 }
 
-// Returns the number of seconds represented by a Clock as a long double
-long double clockSeconds(Clock t){
-	return (long double)t.seconds + (long double)t.nanoseconds \
-		/ (long double)BILLION;
+// Returns the number of seconds represented by a time as a long double
+long double timeToSeconds(Time t){
+	return (long double) t / NS_PER_SECOND;
 }
 
-// Formats and prints the time on the clock to the file
-void printTime(FILE * fp, const Clock clock){
-	fprintf(fp,
-		FORMAT,
-		clock.seconds,
-		clock.nanoseconds
-	);
+// Formats and prints the time to the file
+void printTime(FILE * fp, Time t){
+	fprintf(fp, FORMAT, timeSeconds(t), timeNanoseconds(t));
 }
 
-// Formats and prints the time on the clock to the file and a new line char
-void printTimeln(FILE * fp, const Clock clock){
-	fprintf(fp,
-		FORMAT_LN,
-		clock.seconds,
-		clock.nanoseconds
-	);
+// Formats and prints the time to the file and a new line char
+void printTimeln(FILE * fp, Time t){
+	fprintf(fp, FORMAT_LN, timeSeconds(t), timeNanoseconds(t));
 }
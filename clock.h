@@ -1,30 +1,30 @@
 // clock.h was created by Mark Renard on 2/21/2020 and modified on 4/17/2020.
 //
 // This file defines a type used to simulate a clock in a shared memory region.
+// Simulated times are counts of nanoseconds, so they are added, subtracted,
+// and compared directly, and split into seconds and nanoseconds only to be
+// printed as %03d : %09d.
 
 #ifndef CLOCK_H
 #define CLOCK_H
 
+#include <stdint.h>
 #include <stdio.h>
 
-// Uses two unsigned ints as a clock
-typedef struct clock {
-	unsigned int seconds;
-	unsigned int nanoseconds;
-} Clock;
+#define NS_PER_SECOND 1000000000UL	// Nanoseconds in a second
 
-Clock zeroClock();
-Clock newClock(unsigned int seconds, unsigned int nanoseconds);
-Clock randomTime(Clock min, Clock max);
-void copyTime(Clock * dest, const Clock src);
-void incrementClock(Clock * clock, const Clock increment);
-int clockCompare(const Clock clk1, const Clock clk2);
-Clock clockSum(Clock t1, Clock t2);
-Clock clockDiff(Clock t1, Clock t2);
-Clock clockDiv(Clock t, unsigned int n);
-long double clockSeconds(Clock t);
-long double clockRatio(Clock t1, Clock t2);
-void printTime(FILE * fp, const Clock clock);
-void printTimeln(FILE * fp, const Clock clock);
+// Uses a 64 bit count of nanoseconds as a time
+typedef uint64_t Time;
+
+// Converts a number of seconds and nanoseconds to a Time
+#define TIME(seconds, nanoseconds) \
+	((Time) (seconds) * NS_PER_SECOND + (nanoseconds))
+
+Time randomTime(Time min, Time max);
+unsigned int timeSeconds(Time t);
+unsigned int timeNanoseconds(Time t);
+long double timeToSeconds(Time t);
+void printTime(FILE * fp, Time t);
+void printTimeln(FILE * fp, Time t);
 
 #endif
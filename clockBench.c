@@ -0,0 +1,217 @@
+// clockBench.c was created by Mark Renard on 5/12/2020.
+//
+// This program measures how reads of the shared clock scale with the number
+// of processes reading it. For each process count given, it forks that many
+// processes, which start together and each read a ProtectedClock in shared
+// memory a number of times, and reports the reads per second of all of them
+// and the time each read took. The same is done for a clock guarded by a
+// process-shared mutex, the way the clock was shared before it became a
+// single atomic counter. With -w, one of every n reads also advances the
+// clock, as oss does while processes read it.
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "clock.h"
+#include "constants.h"
+#include "perrorExit.h"
+#include "protectedClock.h"
+
+#define DEFAULT_READS 5000000	// Reads each process makes by default
+
+// A clock guarded by a mutex, as the shared clock was before it was atomic
+typedef struct mutexClock {
+	pthread_mutex_t lock;	// Lock held to read or advance the time
+	Time ns;		// Nanoseconds elapsed
+} MutexClock;
+
+// Shared memory holding both clocks and the flag the processes start on
+typedef struct benchShm {
+	ProtectedClock clock;	// The clock oss shares
+	MutexClock mutexClock;	// The clock it replaced
+	_Atomic bool start __attribute__((aligned(CACHE_LINE_SIZE)));
+} BenchShm;
+
+// Prototypes
+static void getBenchOptions(int argc, char * argv[]);
+static void printUsageExit();
+static double runBench(int numProcs, bool atomic);
+static void readClock(bool atomic);
+static double seconds(const struct timespec * start,
+		      const struct timespec * stop);
+
+// Static global variables
+static long reads = DEFAULT_READS;	// Reads each process makes
+static long writeEvery = 0;		// Reads per write, or 0 for none
+static BenchShm * shm;			// Memory shared with the readers
+
+int main(int argc, char * argv[]){
+	pthread_mutexattr_t attr;
+	double mutexSeconds;	// Time every reader took with the mutex
+	double atomicSeconds;	// The same with the atomic clock
+	long total;		// Reads made by every reader
+	int numProcs;
+	int i;
+
+	exeName = argv[0];	// Assigns exeName for perrorExit
+	signalGroup = false;	// Exits alone on errors, outside oss
+
+	getBenchOptions(argc, argv);
+
+	shm = mmap(NULL, sizeof(BenchShm), PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shm == MAP_FAILED)
+		perrorExit("Failed to map shared memory");
+
+	initPClock(&shm->clock);
+	if (pthread_mutexattr_init(&attr) != 0
+	    || pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) != 0
+	    || pthread_mutex_init(&shm->mutexClock.lock, &attr) != 0)
+		perrorExit("Failed to initialize the mutex");
+	shm->mutexClock.ns = 0;
+
+	printf("%ld reads per process, %s, on %ld processors\n\n", reads,
+	       writeEvery == 0 ? "no writes" : "with writes",
+	       sysconf(_SC_NPROCESSORS_ONLN));
+	printf("  procs   mutex: Mreads/s  ns/read    atomic: Mreads/s  "
+	       "ns/read\n");
+
+	// Reports the throughput of all readers and the time of each read
+	for (i = optind; i < argc; i++){
+		numProcs = atoi(argv[i]);
+		total = reads * numProcs;
+		mutexSeconds = runBench(numProcs, false);
+		atomicSeconds = runBench(numProcs, true);
+
+		printf("  %5d  %16.1f  %7.1f  %16.1f  %7.1f\n", numProcs,
+		       total / mutexSeconds / 1e6,
+		       mutexSeconds / reads * 1e9,
+		       total / atomicSeconds / 1e6,
+		       atomicSeconds / reads * 1e9);
+	}
+
+	pthread_mutex_destroy(&shm->mutexClock.lock);
+	munmap(shm, sizeof(BenchShm));
+	return 0;
+}
+
+// Sets the options from the command line or exits with a usage message
+static void getBenchOptions(int argc, char * argv[]){
+	char * end;
+	int option;
+	int i;
+
+	while ((option = getopt(argc, argv, "n:w:")) != -1){
+		switch (option){
+		case 'n':
+			reads = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || reads < 1)
+				printUsageExit();
+			break;
+		case 'w':
+			writeEvery = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || writeEvery < 0)
+				printUsageExit();
+			break;
+		default:
+			printUsageExit();
+		}
+	}
+
+	if (optind == argc) printUsageExit();
+	for (i = optind; i < argc; i++)
+		if (atoi(argv[i]) < 1) printUsageExit();
+}
+
+// Prints usage message on incorrect usage and exits
+static void printUsageExit(){
+	fprintf(stderr, "\nusage: \n\t%s [-n reads] [-w n] procs...\n\n"
+		"Forks each number of processes in procs, which read the "
+		"shared clock\ntogether, and reports how many reads they "
+		"made per second, with the\natomic clock oss uses and with "
+		"a mutex-guarded clock.\n\noptions:\n"
+		"\t-n reads\tmake reads reads in each process (default %d)\n"
+		"\t-w n\talso advance the clock on one of every n reads\n\n"
+		"example:\n\t%s 1 2 4 8 16\n", exeName, DEFAULT_READS,
+		exeName);
+	exit(1);
+}
+
+// Forks the readers, starts them together, and returns the seconds until
+// the last finished
+static double runBench(int numProcs, bool atomic){
+	struct timespec start, stop;
+	int status;	// Exit status of a reader
+	pid_t pid;
+	int i;
+
+	atomic_store(&shm->start, false);
+
+	for (i = 0; i < numProcs; i++){
+		if ((pid = fork()) == -1)
+			perrorExit("Failed to fork a reader");
+
+		if (pid == 0){
+			while (!atomic_load(&shm->start));
+			readClock(atomic);
+			_exit(0);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	atomic_store(&shm->start, true);
+
+	for (i = 0; i < numProcs; i++){
+		if (wait(&status) == -1)
+			perrorExit("Failed to wait for a reader");
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+			fprintf(stderr, "%s: Error: A reader failed\n",
+				exeName);
+			exit(1);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+
+	return seconds(&start, &stop);
+}
+
+// Reads one of the clocks, advancing it on every writeEvery-th read
+static void readClock(bool atomic){
+	MutexClock * mutexClock = &shm->mutexClock;
+	volatile Time sink;	// Keeps the reads from being optimized away
+	long i;
+
+	for (i = 1; i <= reads; i++){
+		if (atomic){
+			sink = getPTime(&shm->clock);
+			if (writeEvery != 0 && i % writeEvery == 0)
+				incrementPClock(&shm->clock, 1);
+			continue;
+		}
+
+		pthread_mutex_lock(&mutexClock->lock);
+		sink = mutexClock->ns;
+		if (writeEvery != 0 && i % writeEvery == 0)
+			mutexClock->ns++;
+		pthread_mutex_unlock(&mutexClock->lock);
+	}
+
+	(void) sink;
+}
+
+// Returns the seconds from start to stop
+static double seconds(const struct timespec * start,
+		      const struct timespec * stop){
+	return (stop->tv_sec - start->tv_sec)
+	       + (stop->tv_nsec - start->tv_nsec) / 1e9;
+}
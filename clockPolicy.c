@@ -0,0 +1,50 @@
+// clockPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains second-chance (clock) page replacement using the
+// reference bitmap. A hand sweeps the frames, clearing set reference bits,
+// and evicts the first frame whose bit is already clear. The sweep is done a
+// word of 64 frames at a time.
+
+#include "constants.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static void clockInit(FrameBits * frameBits, int numFrames,
+		      const Trace * trace);
+static void clockAllocate(int frameNum, PageKey key);
+static void clockReference(int frameNum, PageKey key);
+static int clockEvict(PageKey key);
+static void clockFree(int frameNum);
+
+const ReplacementPolicy CLOCK_POLICY = {
+	"clock", clockInit, clockAllocate, clockReference, clockEvict,
+	clockFree, false
+};
+
+// Static global variables
+static FrameBits * bits;	// Reference bits swept by the hand
+static int headIndex;		// Frame the hand points to
+
+// Starts the hand at the first frame
+static void clockInit(FrameBits * frameBits, int numFrames,
+		      const Trace * trace){
+	bits = frameBits;
+	headIndex = 0;
+}
+
+// Relies on oss setting the frame's reference bit
+static void clockAllocate(int frameNum, PageKey key){
+}
+
+// Relies on oss setting the frame's reference bit
+static void clockReference(int frameNum, PageKey key){
+}
+
+// Returns the frame number of a victim frame using clock replacement
+static int clockEvict(PageKey key){
+	return sweepClock(bits, &headIndex);
+}
+
+// Keeps no state about frames
+static void clockFree(int frameNum){
+}
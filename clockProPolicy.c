@@ -0,0 +1,310 @@
+// clockProPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains CLOCK-Pro page replacement, as described by Jiang, Chen
+// and Zhang. Resident pages are hot or cold, and a cold page that is
+// referenced again during its test period becomes hot. Pages are kept on one
+// circular list swept by three hands: the cold hand evicts cold pages, the
+// hot hand demotes hot pages, and the test hand ends test periods. Keys of
+// evicted pages still being tested stay on the list as non-resident pages,
+// and a fault on one grows the target number of cold pages.
+
+#include <stdbool.h>
+
+#include "constants.h"
+#include "pageMap.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static void clockProInit(FrameBits * frameBits, int numFrames,
+			 const Trace * trace);
+static void clockProAllocate(int frameNum, PageKey key);
+static void clockProReference(int frameNum, PageKey key);
+static int clockProEvict(PageKey key);
+static void clockProFree(int frameNum);
+static void runHandHot();
+static void runHandTest();
+static void endTest(int entry);
+static void insertAtHead(int entry);
+static void removeEntry(int entry);
+static int advance(int hand);
+
+const ReplacementPolicy CLOCK_PRO_POLICY = {
+	"clockpro", clockProInit, clockProAllocate, clockProReference,
+	clockProEvict, clockProFree, false
+};
+
+// Static global variables
+static int * next;		// Entry after each entry on the circular list
+static int * previous;		// Entry before each entry on the list
+static PageKey * keys;		// Key of the page of each entry
+static int * entryFrame;	// Frame of each entry or EMPTY if non-resident
+static bool * hot;		// Whether each entry is hot
+static bool * test;		// Whether each cold entry is in its test period
+static bool * ref;		// Whether each entry was referenced
+static int * frameEntry;	// Entry of each allocated frame
+
+static int * unused;		// Stack of entries not on the list
+static int numUnused;		// Number of entries on the stack
+
+static PageMap nonResident;	// Entry of each non-resident key
+
+static int handHot;		// Entry the hot hand points to
+static int handCold;		// Entry the cold hand points to
+static int handTest;		// Entry the test hand points to
+
+static int capacity;		// Number of frames
+static int coldTarget;		// Target number of resident cold pages
+static int hotCount;		// Number of hot pages
+static int coldCount;		// Number of resident cold pages
+static int nonResidentCount;	// Number of non-resident pages in test
+
+// Starts with an empty list and the smallest cold target
+static void clockProInit(FrameBits * frameBits, int numFrames,
+			 const Trace * trace){
+	int size = 2 * numFrames + 1;	// Resident and non-resident entries
+	int i;
+
+	capacity = numFrames;
+	coldTarget = 1;
+	hotCount = 0;
+	coldCount = 0;
+	nonResidentCount = 0;
+	handHot = handCold = handTest = EMPTY;
+
+	next = policyAlloc(sizeof(int) * size);
+	previous = policyAlloc(sizeof(int) * size);
+	keys = policyAlloc(sizeof(PageKey) * size);
+	entryFrame = policyAlloc(sizeof(int) * size);
+	hot = policyAlloc(sizeof(bool) * size);
+	test = policyAlloc(sizeof(bool) * size);
+	ref = policyAlloc(sizeof(bool) * size);
+	frameEntry = policyAlloc(sizeof(int) * numFrames);
+	unused = policyAlloc(sizeof(int) * size);
+	initPageMap(&nonResident, size);
+
+	for (numUnused = 0; numUnused < size; numUnused++)
+		unused[numUnused] = size - numUnused - 1;
+
+	for (i = 0; i < numFrames; i++)
+		frameEntry[i] = EMPTY;
+}
+
+// Adds a new page as cold in its test period, or a tested page as hot
+static void clockProAllocate(int frameNum, PageKey key){
+	int entry;
+
+	// Makes a non-resident page in its test period hot
+	if ((entry = pageMapGet(&nonResident, key)) != EMPTY){
+		if (coldTarget < capacity - 1) coldTarget++;
+
+		pageMapRemove(&nonResident, key);
+		removeEntry(entry);
+		nonResidentCount--;
+
+		hot[entry] = true;
+		test[entry] = false;
+		hotCount++;
+	}
+
+	// Adds a new page as cold in its test period
+	else {
+		entry = unused[--numUnused];
+		keys[entry] = key;
+		hot[entry] = false;
+		test[entry] = true;
+		coldCount++;
+	}
+
+	ref[entry] = false;
+	entryFrame[entry] = frameNum;
+	frameEntry[frameNum] = entry;
+	insertAtHead(entry);
+
+	// Demotes hot pages until the cold target is met
+	while (hotCount > capacity - coldTarget)
+		runHandHot();
+}
+
+// Sets the reference bit of a resident page
+static void clockProReference(int frameNum, PageKey key){
+	if (frameNum != EMPTY)
+		ref[frameEntry[frameNum]] = true;
+}
+
+// Runs the cold hand until it finds an unreferenced cold page to evict
+static int clockProEvict(PageKey key){
+	int entry;
+	int frameNum;
+
+	while (true){
+
+		// Demotes a hot page if there are no resident cold pages
+		if (coldCount == 0)
+			runHandHot();
+
+		entry = handCold;
+
+		// Skips hot and non-resident pages
+		if (hot[entry] || entryFrame[entry] == EMPTY){
+			handCold = advance(handCold);
+		}
+
+		// Promotes a cold page referenced during its test period
+		else if (ref[entry] && test[entry]){
+			ref[entry] = false;
+			test[entry] = false;
+			hot[entry] = true;
+			coldCount--;
+			hotCount++;
+			handCold = advance(handCold);
+
+			while (hotCount > capacity - coldTarget)
+				runHandHot();
+		}
+
+		// Starts a new test period for a referenced cold page
+		else if (ref[entry]){
+			ref[entry] = false;
+			test[entry] = true;
+			removeEntry(entry);
+			insertAtHead(entry);
+		}
+
+		// Evicts an unreferenced cold page
+		else break;
+	}
+
+	frameNum = entryFrame[entry];
+	entryFrame[entry] = EMPTY;
+	frameEntry[frameNum] = EMPTY;
+	coldCount--;
+	handCold = advance(handCold);
+
+	// Remembers the page while its test period lasts
+	if (test[entry]){
+		pageMapPut(&nonResident, keys[entry], entry);
+		nonResidentCount++;
+
+		while (nonResidentCount > capacity)
+			runHandTest();
+	}
+	else {
+		removeEntry(entry);
+		unused[numUnused++] = entry;
+	}
+
+	return frameNum;
+}
+
+// Forgets a page freed by a terminating process
+static void clockProFree(int frameNum){
+	int entry = frameEntry[frameNum];
+
+	if (hot[entry])
+		hotCount--;
+	else
+		coldCount--;
+
+	entryFrame[entry] = EMPTY;
+	frameEntry[frameNum] = EMPTY;
+	removeEntry(entry);
+	unused[numUnused++] = entry;
+}
+
+// Moves the hot hand until it demotes a hot page, ending test periods
+static void runHandHot(){
+	int entry;
+
+	while (hotCount > 0){
+		entry = handHot;
+		handHot = advance(handHot);
+
+		// Demotes an unreferenced hot page or clears its reference
+		if (hot[entry]){
+			if (ref[entry]){
+				ref[entry] = false;
+			}
+			else {
+				hot[entry] = false;
+				hotCount--;
+				coldCount++;
+				return;
+			}
+		}
+
+		// Ends the test period of a cold page
+		else if (test[entry]){
+			endTest(entry);
+		}
+	}
+}
+
+// Moves the test hand until it removes a non-resident page
+static void runHandTest(){
+	int entry;
+
+	while (nonResidentCount > 0){
+		entry = handTest;
+		handTest = advance(handTest);
+
+		if (!hot[entry] && test[entry]){
+			endTest(entry);
+
+			if (entryFrame[entry] == EMPTY)
+				return;
+		}
+	}
+}
+
+// Ends a cold page's test period, removing it if it is non-resident
+static void endTest(int entry){
+	test[entry] = false;
+
+	if (entryFrame[entry] != EMPTY) return;
+
+	if (coldTarget > 1) coldTarget--;
+
+	pageMapRemove(&nonResident, keys[entry]);
+	removeEntry(entry);
+	nonResidentCount--;
+	unused[numUnused++] = entry;
+}
+
+// Adds an entry behind the hot hand, the last place it will reach
+static void insertAtHead(int entry){
+
+	// Starts a list of one entry with every hand pointing to it
+	if (handHot == EMPTY){
+		next[entry] = entry;
+		previous[entry] = entry;
+		handHot = handCold = handTest = entry;
+		return;
+	}
+
+	next[entry] = handHot;
+	previous[entry] = previous[handHot];
+	next[previous[handHot]] = entry;
+	previous[handHot] = entry;
+}
+
+// Removes an entry from the list, moving hands that point to it forward
+static void removeEntry(int entry){
+
+	// Empties the list if the entry is the only one
+	if (next[entry] == entry){
+		handHot = handCold = handTest = EMPTY;
+		return;
+	}
+
+	if (handHot == entry) handHot = next[entry];
+	if (handCold == entry) handCold = next[entry];
+	if (handTest == entry) handTest = next[entry];
+
+	next[previous[entry]] = next[entry];
+	previous[next[entry]] = previous[entry];
+}
+
+// Returns the entry after the one a hand points to
+static int advance(int hand){
+	return next[hand];
+}
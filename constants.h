@@ -14,16 +14,19 @@
 // Miscelaneous
 #define MAX_RUNNING 18 	 		// Max number of running child processes
 #define MAX_LAUNCHED 100		// Max total children launched
+#define MAX_PROCESSES 1000000		// Max running processes with -n
 
-#define PAGE_SIZE 1024			// Size of one page in bytes
-#define NUM_FRAMES 256			// Total frames in main memory
+#define PAGE_SIZE 1024			// Default size of one page in bytes
+#define MAX_PAGE_SIZE (1 << 20)		// Max size of one page with -z
+#define NUM_FRAMES 256			// Default total frames in main memory
+#define MAX_FRAMES (1 << 26)		// Max total frames with -f
 #define MIN_ALLOC_PAGES 1		// Min number of pages per process
-#define MAX_ALLOC_PAGES 32		// Max number of pages per process
+#define MAX_ALLOC_PAGES 32		// Default max number of pages per process
+#define MAX_PAGES (1 << 20)		// Max pages per process with -a
 
 #define BILLION 1000000000U		// The number of nanoseconds in a second
 #define MILLION 1000000U		// Number of nanoseconds per millisecond
 #define BUFF_SZ 100			// The size of character buffers 
-#define MSG_SZ 30			// Size of qMsg char arrays
 
 #define EMPTY -1			// Generic sentinel for unset values
 
@@ -34,21 +37,53 @@
 #define MAX_FORK_TIME_SEC 0U		// Value of seconds in MAX_FORK_TIME
 #define MAX_FORK_TIME_NS (500 * MILLION)// Value of nanoseconds in MAX_FORK_TIME
 
-#define SLEEP_NS 500000U		// Real sleep between simulation loops
+#define SLEEP_NS (10 * MILLION)		// Max real time oss sleeps while idle
 
 #define USER_PROG_PATH "./userProgram"	// The path to the user program
+#define IN_PROCESS_PID 0		// realPid of processes simulated in oss
 
 #define MEM_ACCESS_SEC 0		// Time to access main memory seconds
 #define MEM_ACCESS_NS 10		// Time to access main memory nanosec
 
 #define IO_OPERATION_SEC 0		// Seconds to perform disk read/write
 #define IO_OPERATION_NS (14 * MILLION)	// Disk read/write nanoseconds
+#define DISK_CHANNELS 1			// Faults paged at once on flat storage
+#define MAX_DISK_CHANNELS 1024		// Max faults paged at once with -d
+#define PAGEOUT_HIGH_FACTOR 2		// Default high watermark per low one
+#define FREE_HIGH_FACTOR 2		// Default free pool high per low watermark
+#define MAX_READ_AHEAD 1024		// Max pages read ahead with -A
+#define READ_AHEAD_WINDOW 2		// Pages first read ahead on a stream
+
+// Used by hddStorage.c and flashStorage.c
+#define HDD_QUEUE_DEPTH 1		// Default faults paged at once on a hdd
+#define HDD_SLOTS_PER_TRACK 128		// Swap slots on each hdd track
+#define HDD_ROTATION_NS 8333333		// Time of one turn at 7200 rpm
+#define HDD_MIN_SEEK_NS 800000		// Time to seek to the next cylinder
+#define HDD_MAX_SEEK_NS (15 * MILLION)	// Time to seek across every cylinder
+#define SSD_QUEUE_DEPTH 32		// Default faults paged at once on a ssd
+#define SSD_READ_NS 80000		// Time for a ssd to read a page
+#define SSD_WRITE_NS 500000		// Time for a ssd to write a page
+#define SSD_UNITS 8			// Flash units in a ssd
+#define NVME_QUEUE_DEPTH 128		// Default faults paged at once on nvme
+#define NVME_READ_NS 10000		// Time for nvme to read a page
+#define NVME_WRITE_NS 20000		// Time for nvme to write a page
+#define NVME_UNITS 64			// Flash units in a nvme drive
 
 #define MEM_MAP_PRINT_INTERVAL_SEC 1	// Interval between memory map prints sec
 #define MEM_MAP_PRINT_INTERVAL_NS 0	// Interval between memory map prints ns
 
 #define MAX_EXEC_SECONDS 5 		// Maximum total execution time
 
+#define INITIAL_EVENTS 64		// Initial capacity of the event heap
+
+#define TLB_ENTRIES 64			// Default entries in the tlb
+#define TLB_WAYS 4			// Default entries per tlb set
+#define MAX_TLB_ENTRIES (1 << 20)	// Max entries in the tlb with -l
+#define TLB_ACCESS_SEC 0		// Time to look up a page in the tlb sec
+#define TLB_ACCESS_NS 1			// Time to look up a page in the tlb ns
+#define TLB_SEED 2463534242U		// Seed of random tlb replacement
+#define TLB_HASH_MULTIPLIER 2654435761U	// Spreads simPids across tlb sets
+
 // Used by userProgram.c
 #define READ_PROBABILITY 0.8		// Chance of read instead of write
 
@@ -71,20 +106,65 @@
 #define REPLY_MQ_KEY 38257848		// Message queue key for replies
 #define MQ_PERMS (S_IRUSR | S_IWUSR)	// Message queue permissions
 
+#define CACHE_LINE_SIZE 64		// Alignment of shared ring fields
+#define RING_SIZE 64			// Requests per ring, a power of two
+#define MAX_BATCH_SIZE RING_SIZE	// Max references sent in one request
+#define RING_SPINS 1000			// Reply polls before sleeping
+
 #define BASE_SEED 39393984		// Used in calls to srand
 
-#define TERMINATE (MAX_ALLOC_PAGES * PAGE_SIZE + 1)  // Termination sentinel
-#define NO_MESSAGE (MAX_ALLOC_PAGES * PAGE_SIZE + 2) // No message sentinel
+#define PAGE_TABLE_BITS 6		// Bits of page number used per level
+#define PAGE_TABLE_FANOUT (1 << PAGE_TABLE_BITS) // Entries per node
+#define MAX_PAGE_TABLE_DEPTH 4		// Levels needed for MAX_PAGES pages
+
+
+// Used by trace.c
+#define TRACE_MAGIC "OSSTRC2\n"	// First bytes of a trace file
+#define TRACE_MAGIC_SIZE 8		// Length of TRACE_MAGIC
+#define TRACE_HEADER_SIZE 12		// TRACE_MAGIC and a 4 byte page size
+#define TRACE_BUFFER_SIZE (1 << 16)	// Bytes of records written at once
+#define TRACE_MAX_RECORD_SIZE 30	// Bytes in a record of the longest varints
+#define MAX_VARINT_BYTES 10		// Bytes in the longest 64 bit varint
+#define MAX_TRACE_PROCESSES (1 << 20)	// Max processes in a replayed trace
+#define INITIAL_TRACE_PROCESSES 64	// Initial processes tracked when coding
+
+
+// Used by traceImport.c
+#define IMPORT_BUFFER_SIZE (1 << 20)	// Bytes of an input file read at once
+#define IMPORT_INITIAL_SLOTS 1024	// Initial slots of a page number table
+#define IMPORT_HASH_MULTIPLIER 0x9e3779b97f4a7c15UL	// 2^64 / golden ratio
+#define IMPORT_QUANTUM 1		// References taken from a file in turn
+#define IMPORT_REFERENCE_NS 10		// Time recorded between references
+
+
+// Used by stats.c and histogram.c
+#define HISTOGRAM_MAX_BITS 42		// Bits of the longest time bucketed
+#define HISTOGRAM_SUB_BITS 5		// Buckets per power of two are 2^this
+#define PROCESS_HISTOGRAM_SUB_BITS 3	// The same for each process
+#define INITIAL_PROCESS_SUMMARIES 64	// Initial terminated processes kept
 
 
-// Used by bitVector.c to track allocated frames
-#define NUM_BITS (sizeof(unsigned int) * 8)  // Bits per unsigned int
-#define MAX_VALUE (NUM_FRAMES - 1) 	   // Max int tracked in bit vector
-#define BIT_VECTOR_SIZE (MAX_VALUE / NUM_BITS + 1) // Size of bit vector
+// Used by trials.c
+#define OSS_PATH "./oss"		// The path to oss
+#define DEFAULT_TRIALS 35		// Trials of each configuration
+#define TRIAL_BASE_SEED 1		// Seed of the first trial
+#define DEFAULT_CONFIDENCE 0.95		// Level of confidence intervals
+#define MAX_CONFIGS 2			// Configurations compared
+#define T_CRITICAL_MAX 1000.0		// Largest critical t searched
+#define T_CRITICAL_STEPS 100		// Bisections finding a critical t
+#define BETA_MAX_TERMS 300		// Terms of the beta continued fraction
+#define BETA_EPSILON 1e-15		// Change ending the continued fraction
+#define BETA_TINY 1e-300		// Replaces zeros in the fraction
 
 
 // Used by logging.c
 #define LOG_FILE_NAME "oss_log"		// The name of the log file
 #define MAX_LOG_LINES 1000000		// Max number of lines in the log file
+#define MAX_MAP_PAGES 64		// Widest page table drawn in the log
+#define LOG_MAGIC "OSSLOG1\n"		// First bytes of a log file
+#define LOG_HEADER_SIZE 8		// Length of LOG_MAGIC
+#define LOG_RING_EVENTS (1 << 16)	// Records buffered, a power of 2
+#define LOG_POLL_NS (1 * MILLION)	// Real time the writer sleeps if idle
+#define LOG_TEXT_SIZE 2048		// Longest text logged at once
 
 #endif
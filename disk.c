@@ -0,0 +1,264 @@
+// disk.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains functions that choose queued faults, and start and
+// finish their paging transfers on the channels of the disk. A fault takes
+// the lowest numbered idle channel, which reads its page and any pages read
+// ahead with it, first writing the victim back if it is dirty. The pageout
+// daemon and the reclaimer also write dirty frames back on idle channels,
+// and a read waits for those still writing its frame or slot. Each channel
+// counts the faults it serviced, the frames it cleaned, and the time it was
+// busy, and the time spent on faults and on write backs is added to the
+// statistics separately.
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "disk.h"
+#include "perrorExit.h"
+#include "stats.h"
+
+// Prototypes
+static long faultSlot(const Disk * disk, const PCB * pcb);
+static long seekCost(const Disk * disk, long slot);
+static Channel * idleChannel(Disk * disk);
+static Time afterWriteBack(const Disk * disk, int frameNum, long slot,
+			   Time time);
+
+// Constants
+static const char * SCHEDULE_NAMES[NUM_SCHEDULES] = {
+	"fifo", "sstf", "scan", "clook"
+};
+
+// Allocates a disk with every channel idle and the head at the first slot
+void initDisk(Disk * disk, int numChannels, const StorageModel * model,
+	      DiskSchedule schedule, int slotsPerProcess, int pageSize){
+	int i;
+
+	disk->channels = malloc(sizeof(Channel) * numChannels);
+	if (disk->channels == NULL)
+		perrorExit("initDisk failed to allocate channels");
+
+	for (i = 0; i < numChannels; i++){
+		disk->channels[i].pcb = NULL;
+		disk->channels[i].frameNum = EMPTY;
+		disk->channels[i].busyTime = 0;
+		disk->channels[i].transfers = 0;
+		disk->channels[i].pageouts = 0;
+	}
+
+	disk->numChannels = numChannels;
+	disk->inFlight = 0;
+	disk->cleaning = 0;
+	disk->model = model;
+	disk->schedule = schedule;
+	disk->slotsPerProcess = slotsPerProcess;
+	disk->pageSize = pageSize;
+	disk->head = 0;
+	disk->ascending = true;
+}
+
+// Frees the channels of a disk
+void freeDisk(Disk * disk){
+	free(disk->channels);
+	disk->channels = NULL;
+}
+
+// Returns true if a channel can start another transfer
+bool channelIdle(const Disk * disk){
+	return disk->inFlight + disk->cleaning < disk->numChannels;
+}
+
+// Returns the swap slot holding a process's page
+long swapSlot(const Disk * disk, int processNum, int pageNum){
+	return (long) processNum * disk->slotsPerProcess + pageNum;
+}
+
+// Removes and returns the queued fault the schedule starts next, taking the
+// fault queued first among those that are equally near
+PCB * nextFault(Disk * disk, Queue * q){
+	PCB * best = q->front;	// Fault chosen so far
+	PCB * pcb;
+	long slot;
+
+	if (disk->schedule == FIFO_SCHEDULE) return dequeue(q);
+
+	for (pcb = q->front->previous; pcb != NULL; pcb = pcb->previous)
+		if (seekCost(disk, faultSlot(disk, pcb))
+		    < seekCost(disk, faultSlot(disk, best)))
+			best = pcb;
+
+	// Reverses a scan that found nothing ahead of the head
+	slot = faultSlot(disk, best);
+	if (disk->schedule == SCAN_SCHEDULE && slot != disk->head)
+		disk->ascending = slot > disk->head;
+
+	removeFromCurrentQueue(best);
+	return best;
+}
+
+// Starts reading a process's page into a frame on an idle channel, after
+// writing back the victim to victimSlot unless it is EMPTY, and then the
+// process's pages in readAhead into aheadFrames in the same transfer, each
+// after writing back its victim in aheadVictims, and returns the time the
+// last read completes. Each read waits for any write back from its frame or
+// to its slot
+Time startPaging(Disk * disk, PCB * pcb, int frameNum, long victimSlot,
+		 const int * readAhead, const int * aheadFrames,
+		 const long * aheadVictims, int numReadAhead, Time now){
+	Channel * channel = idleChannel(disk);
+	Time time = now;	// Time the next transfer starts
+	int i;
+
+	channel->pcb = pcb;
+	channel->frameNum = frameNum;
+	channel->start = now;
+	disk->inFlight++;
+
+	if (victimSlot != EMPTY)
+		time += disk->model->transfer(victimSlot, true, time);
+
+	disk->head = faultSlot(disk, pcb);
+	time = afterWriteBack(disk, frameNum, disk->head, time);
+	time += disk->model->transfer(disk->head, false, time);
+
+	for (i = 0; i < numReadAhead; i++){
+		if (aheadVictims[i] != EMPTY)
+			time += disk->model->transfer(aheadVictims[i], true,
+						      time);
+
+		disk->head = swapSlot(disk, pcb->processNum, readAhead[i]);
+		time = afterWriteBack(disk, aheadFrames[i], disk->head,
+				      time);
+		time += disk->model->transfer(disk->head, false, time);
+	}
+
+	return time;
+}
+
+// Frees the channel servicing a process's fault, returning its pcb and the
+// frame its page was read into
+PCB * finishPaging(Disk * disk, int simPid, Time now, int * frameNum){
+	Channel * channel = disk->channels;
+	PCB * pcb;
+
+	while (channel->pcb == NULL || channel->pcb->simPid != simPid)
+		if (++channel == disk->channels + disk->numChannels)
+			perrorExit("I/O completed for a process not paging");
+
+	channel->busyTime += now - channel->start;
+	channel->transfers++;
+	statsAdd(STAT_DISK_BUSY_TIME, now - channel->start);
+	statsCount(STAT_PAGE_INS);
+
+	pcb = channel->pcb;
+	*frameNum = channel->frameNum;
+	channel->pcb = NULL;
+	channel->frameNum = EMPTY;
+	disk->inFlight--;
+
+	return pcb;
+}
+
+// Starts writing a dirty frame back to its slot on an idle channel and
+// returns the time the write will complete
+Time startCleaning(Disk * disk, int frameNum, long slot, Time now){
+	Channel * channel = idleChannel(disk);
+
+	channel->frameNum = frameNum;
+	channel->slot = slot;
+	channel->start = now;
+	channel->end = now + disk->model->transfer(slot, true, now);
+	disk->cleaning++;
+
+	return channel->end;
+}
+
+// Frees the channel that wrote a frame back
+void finishCleaning(Disk * disk, int frameNum, Time now){
+	Channel * channel = disk->channels;
+
+	while (channel->pcb != NULL || channel->frameNum != frameNum)
+		if (++channel == disk->channels + disk->numChannels)
+			perrorExit("I/O completed for a frame not cleaning");
+
+	channel->busyTime += now - channel->start;
+	channel->pageouts++;
+	statsAdd(STAT_WRITE_BACK_BUSY_TIME, now - channel->start);
+
+	channel->frameNum = EMPTY;
+	disk->cleaning--;
+}
+
+// Returns the schedule with the name or -1 if none exists
+int getDiskSchedule(const char * name){
+	int i;
+
+	for (i = 0; i < NUM_SCHEDULES; i++)
+		if (strcmp(SCHEDULE_NAMES[i], name) == 0)
+			return i;
+
+	return -1;
+}
+
+// Returns the name of a schedule
+const char * diskScheduleName(DiskSchedule schedule){
+	return SCHEDULE_NAMES[schedule];
+}
+
+// Returns the lowest numbered idle channel or exits with an error message
+static Channel * idleChannel(Disk * disk){
+	Channel * channel = disk->channels;
+
+	while (channel->frameNum != EMPTY)
+		if (++channel == disk->channels + disk->numChannels)
+			perrorExit("Transfer started with no idle channel");
+
+	return channel;
+}
+
+// Returns the swap slot of the page a queued process faulted on
+static long faultSlot(const Disk * disk, const PCB * pcb){
+	return swapSlot(disk, pcb->processNum,
+			pcb->lastReference.address / disk->pageSize);
+}
+
+// Returns how far the schedule places a slot from the head, where slots
+// the head must turn back or wrap around to reach are past every slot ahead
+static long seekCost(const Disk * disk, long slot){
+	long distance = slot > disk->head ? slot - disk->head
+					  : disk->head - slot;
+
+	switch (disk->schedule){
+	case SCAN_SCHEDULE:
+		if ((slot >= disk->head) == disk->ascending
+		    || slot == disk->head)
+			return distance;
+		return LONG_MAX / 2 + distance;
+
+	case CLOOK_SCHEDULE:
+		if (slot >= disk->head) return distance;
+		return LONG_MAX / 2 + slot;
+
+	default:
+		return distance;
+	}
+}
+
+// Returns the later of time and the completion of any write back in progress
+// from a frame or to a slot, which reading the slot into the frame must wait
+// for so that neither the frame nor the page is read before it is written
+static Time afterWriteBack(const Disk * disk, int frameNum, long slot,
+			   Time time){
+	const Channel * channel;
+
+	for (channel = disk->channels;
+	     channel < disk->channels + disk->numChannels; channel++)
+		if (channel->pcb == NULL && channel->frameNum != EMPTY
+		    && (channel->frameNum == frameNum || channel->slot == slot)
+		    && channel->end > time)
+			time = channel->end;
+
+	return time;
+}
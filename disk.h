@@ -0,0 +1,75 @@
+// disk.h was created by Mark Renard on 5/12/2020.
+//
+// This file defines the disk oss pages to and from. The disk has a number of
+// channels that each transfer one fault's pages at a time, so up to that many
+// faults are serviced at once. oss orders their completions in its event
+// heap, so a fault on one channel can finish before one started earlier on
+// another. Idle channels also write back the dirty frames the pageout daemon
+// cleans and the frames the reclaimer evicts. A page is not read until any
+// write back from its frame or to its slot has completed. Each process has a
+// range of swap slots, one for each page it can be allocated, and a storage
+// model times the transfers to them. When a channel is idle, a disk
+// scheduling algorithm picks the queued fault it starts next.
+
+#ifndef DISK_H
+#define DISK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clock.h"
+#include "pcb.h"
+#include "queue.h"
+#include "storageModel.h"
+
+// Orders in which queued faults are started
+typedef enum diskSchedule {
+	FIFO_SCHEDULE,		// The fault queued first
+	SSTF_SCHEDULE,		// The fault nearest the last slot started
+	SCAN_SCHEDULE,		// The nearest fault ahead, reversing at the end
+	CLOOK_SCHEDULE,		// The nearest fault above, wrapping to lowest
+	NUM_SCHEDULES
+} DiskSchedule;
+
+// Stores the transfer in progress on a channel and the work it has done
+typedef struct channel {
+	PCB * pcb;		// Process whose fault is serviced, or NULL
+	int frameNum;		// Frame read into or cleaned, EMPTY if idle
+	Time start;		// Time the transfer started
+	long slot;		// Slot a frame is written back to
+	Time end;		// Time a write back completes
+	Time busyTime;		// Time spent transferring pages
+	uint64_t transfers;	// Faults serviced
+	uint64_t pageouts;	// Dirty frames cleaned
+} Channel;
+
+// Stores the channels of the disk
+typedef struct disk {
+	Channel * channels;	// Array of channels
+	int numChannels;	// Length of channels
+	int inFlight;		// Channels servicing a fault
+	int cleaning;		// Channels cleaning a dirty frame
+	const StorageModel * model;	// Times the transfers
+	DiskSchedule schedule;	// Order queued faults are started in
+	int slotsPerProcess;	// Swap slots of each process
+	int pageSize;		// Bytes in a page
+	long head;		// Slot of the last page read
+	bool ascending;		// Whether a scan is moving to higher slots
+} Disk;
+
+void initDisk(Disk * disk, int numChannels, const StorageModel * model,
+	      DiskSchedule schedule, int slotsPerProcess, int pageSize);
+void freeDisk(Disk * disk);
+bool channelIdle(const Disk * disk);
+long swapSlot(const Disk * disk, int processNum, int pageNum);
+PCB * nextFault(Disk * disk, Queue * q);
+Time startPaging(Disk * disk, PCB * pcb, int frameNum, long victimSlot,
+		 const int * readAhead, const int * aheadFrames,
+		 const long * aheadVictims, int numReadAhead, Time now);
+PCB * finishPaging(Disk * disk, int simPid, Time now, int * frameNum);
+Time startCleaning(Disk * disk, int frameNum, long slot, Time now);
+void finishCleaning(Disk * disk, int frameNum, Time now);
+int getDiskSchedule(const char * name);
+const char * diskScheduleName(DiskSchedule schedule);
+
+#endif
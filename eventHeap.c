@@ -0,0 +1,109 @@
+// eventHeap.c was created by Mark Renard on 5/8/2020.
+//
+// This file contains functions that schedule events in a binary min-heap
+// keyed by simulated time. Events scheduled for the same time are popped in
+// the order they were scheduled, so runs with the same seed are reproducible.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "clock.h"
+#include "constants.h"
+#include "eventHeap.h"
+#include "perrorExit.h"
+
+// Returns true if event a occurs before event b
+static bool before(const Event * a, const Event * b){
+	return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+
+// Swaps two events in the heap
+static void swap(Event * a, Event * b){
+	Event temp = *a;
+	*a = *b;
+	*b = temp;
+}
+
+// Initializes an empty heap
+void initEventHeap(EventHeap * heap){
+	heap->capacity = INITIAL_EVENTS;
+	heap->count = 0;
+	heap->seq = 0;
+
+	if ((heap->events = malloc(sizeof(Event) * heap->capacity)) == NULL)
+		perrorExit("initEventHeap failed to allocate events");
+}
+
+// Frees the memory used by a heap
+void freeEventHeap(EventHeap * heap){
+	free(heap->events);
+	heap->events = NULL;
+	heap->count = 0;
+}
+
+// Adds an event to the heap, doubling its capacity if it is full
+void scheduleEvent(EventHeap * heap, Time time, EventType type, int simPid){
+	int i, parent;
+
+	// Grows the array if necessary
+	if (heap->count == heap->capacity){
+		heap->capacity *= 2;
+		heap->events = realloc(heap->events, 
+				       sizeof(Event) * heap->capacity);
+		if (heap->events == NULL)
+			perrorExit("scheduleEvent failed to allocate events");
+	}
+
+	// Adds the event at the bottom of the heap
+	i = heap->count++;
+	heap->events[i].time = time;
+	heap->events[i].type = type;
+	heap->events[i].simPid = simPid;
+	heap->events[i].seq = heap->seq++;
+
+	// Moves the event up until its parent occurs before it
+	while (i > 0){
+		parent = (i - 1) / 2;
+		if (!before(&heap->events[i], &heap->events[parent])) break;
+
+		swap(&heap->events[i], &heap->events[parent]);
+		i = parent;
+	}
+}
+
+// Returns true if the earliest event occurs at or before the current time
+bool eventDue(const EventHeap * heap, Time now){
+	return heap->count > 0 && heap->events[0].time <= now;
+}
+
+// Removes and returns the earliest event
+Event popEvent(EventHeap * heap){
+	Event earliest;		// The event to return
+	int i = 0;		// Index of the event moving down
+	int child;		// Index of its earliest child
+
+	if (heap->count == 0)
+		perrorExit("Called popEvent on empty heap");
+
+	earliest = heap->events[0];
+
+	// Moves the last event to the top and then down until it is in order
+	heap->events[0] = heap->events[--heap->count];
+	while ((child = 2 * i + 1) < heap->count){
+		if (child + 1 < heap->count
+		    && before(&heap->events[child + 1], &heap->events[child]))
+			child++;
+
+		if (!before(&heap->events[child], &heap->events[i])) break;
+
+		swap(&heap->events[i], &heap->events[child]);
+		i = child;
+	}
+
+	return earliest;
+}
+
+// Returns a pointer to the earliest event, or NULL if there are none
+const Event * peekEvent(const EventHeap * heap){
+	return heap->count > 0 ? &heap->events[0] : NULL;
+}
@@ -0,0 +1,48 @@
+// eventHeap.h was created by Mark Renard on 5/8/2020.
+//
+// This file defines a min-heap of events ordered by the simulated time at
+// which they occur, used by oss to advance the clock directly to the next
+// event when every process is waiting.
+
+#ifndef EVENTHEAP_H
+#define EVENTHEAP_H
+
+#include <stdbool.h>
+
+#include "clock.h"
+
+// Defines the kinds of event oss schedules
+typedef enum eventType {
+	FORK_EVENT,		// Time to launch a user process
+	IO_COMPLETION_EVENT,	// Paging I/O for a process completes
+	PRINT_EVENT,		// Time to print the memory map
+	REFERENCE_EVENT,	// A process simulated in oss makes references
+	PAGEOUT_EVENT,		// A dirty frame has been written back
+	RECLAIM_EVENT		// A reclaimed frame has been written back
+} EventType;
+
+// Stores a scheduled event
+typedef struct event {
+	Time time;		// Simulated time the event occurs
+	EventType type;		// The kind of event
+	int simPid;		// Process, or frame written back, the event
+				// concerns
+	unsigned long seq;	// Order scheduled, which breaks ties in time
+} Event;
+
+// Stores events in a binary heap with the earliest event at index 0
+typedef struct eventHeap {
+	Event * events;		// Array of events in heap order
+	int count;		// Number of events in the heap
+	int capacity;		// Number of events the array can hold
+	unsigned long seq;	// Number of events ever scheduled
+} EventHeap;
+
+void initEventHeap(EventHeap * heap);
+void freeEventHeap(EventHeap * heap);
+void scheduleEvent(EventHeap * heap, Time time, EventType type, int simPid);
+bool eventDue(const EventHeap * heap, Time now);
+Event popEvent(EventHeap * heap);
+const Event * peekEvent(const EventHeap * heap);
+
+#endif
@@ -0,0 +1,51 @@
+// fifoPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains first-in, first-out page replacement, which evicts the
+// frame whose page was loaded least recently regardless of references.
+
+#include "constants.h"
+#include "indexList.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static void fifoInit(FrameBits * frameBits, int numFrames,
+		     const Trace * trace);
+static void fifoAllocate(int frameNum, PageKey key);
+static void fifoReference(int frameNum, PageKey key);
+static int fifoEvict(PageKey key);
+static void fifoFree(int frameNum);
+
+const ReplacementPolicy FIFO_POLICY = {
+	"fifo", fifoInit, fifoAllocate, fifoReference, fifoEvict, fifoFree,
+	false
+};
+
+// Static global variables
+static IndexPool pool;	// Links between frames
+static IndexList loaded;// Allocated frames in the order they were loaded
+
+// Starts with no frames allocated
+static void fifoInit(FrameBits * frameBits, int numFrames,
+		     const Trace * trace){
+	initIndexPool(&pool, numFrames);
+	initIndexList(&loaded, 0);
+}
+
+// Adds the frame to the back of the queue
+static void fifoAllocate(int frameNum, PageKey key){
+	pushBack(&loaded, &pool, frameNum);
+}
+
+// Ignores references
+static void fifoReference(int frameNum, PageKey key){
+}
+
+// Evicts the frame at the front of the queue
+static int fifoEvict(PageKey key){
+	return popFront(&loaded, &pool);
+}
+
+// Removes the frame from the queue
+static void fifoFree(int frameNum){
+	removeIndex(&loaded, &pool, frameNum);
+}
@@ -0,0 +1,81 @@
+// flashStorage.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains models of flash storage, a SATA SSD and an NVMe drive.
+// Swap slots are striped across independent flash units, each of which
+// transfers one page at a time, so transfers to different units overlap and
+// a transfer to a busy unit waits for it. Writes take longer than reads. The
+// two models differ in their latencies, their number of units, and the depth
+// of their queues.
+
+#include <stdlib.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+#include "storageModel.h"
+
+// Latencies and parallelism of a flash device
+typedef struct flashGeometry {
+	Time readTime;	// Time to read a page
+	Time writeTime;	// Time to write a page
+	int units;	// Units transferring pages independently
+} FlashGeometry;
+
+// Prototypes
+static void ssdInit(long numSlots, Time ioTime);
+static void nvmeInit(long numSlots, Time ioTime);
+static void flashInit(const FlashGeometry * newGeometry);
+static Time flashTransfer(long slot, bool write, Time now);
+
+const StorageModel SSD_STORAGE = {
+	"ssd", SSD_QUEUE_DEPTH, ssdInit, flashTransfer
+};
+
+const StorageModel NVME_STORAGE = {
+	"nvme", NVME_QUEUE_DEPTH, nvmeInit, flashTransfer
+};
+
+// Constants
+static const FlashGeometry SSD_GEOMETRY = {
+	SSD_READ_NS, SSD_WRITE_NS, SSD_UNITS
+};
+static const FlashGeometry NVME_GEOMETRY = {
+	NVME_READ_NS, NVME_WRITE_NS, NVME_UNITS
+};
+
+// Static global variables
+static const FlashGeometry * geometry;	// The device modeled
+static Time * freeTimes = NULL;		// Time each unit finishes its work
+
+// Models a SATA SSD
+static void ssdInit(long numSlots, Time ioTime){
+	flashInit(&SSD_GEOMETRY);
+}
+
+// Models an NVMe drive
+static void nvmeInit(long numSlots, Time ioTime){
+	flashInit(&NVME_GEOMETRY);
+}
+
+// Starts every unit of the device idle
+static void flashInit(const FlashGeometry * newGeometry){
+	int i;
+
+	geometry = newGeometry;
+
+	free(freeTimes);
+	if ((freeTimes = malloc(sizeof(Time) * geometry->units)) == NULL)
+		perrorExit("Failed to allocate flash units");
+
+	for (i = 0; i < geometry->units; i++)
+		freeTimes[i] = 0;
+}
+
+// Returns the time until the slot's unit has read or written it
+static Time flashTransfer(long slot, bool write, Time now){
+	Time * unitFree = &freeTimes[slot % geometry->units];
+
+	if (*unitFree < now) *unitFree = now;
+	*unitFree += write ? geometry->writeTime : geometry->readTime;
+
+	return *unitFree - now;
+}
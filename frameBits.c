@@ -0,0 +1,166 @@
+// frameBits.c was created by Mark Renard on 5/11/2020.
+//
+// This file contains functions that set and test bits in the frame bitmaps,
+// find a free frame, and sweep a clock hand over the reference bits or the
+// pageout daemon's hand over the dirty frames a word at a time, so each takes
+// time proportional to the number of frames / 64.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "frameBits.h"
+#include "perrorExit.h"
+
+// Prototypes
+static uint64_t * allocBitmap(int numWords);
+static uint64_t validMask(const FrameBits * bits, int word);
+static int sweep(FrameBits * bits, int * hand, uint64_t * chances,
+		 const uint64_t * required);
+
+// Allocates bitmaps with every frame free, unreferenced, and clean
+void initFrameBits(FrameBits * bits, int numFrames){
+	bits->numFrames = numFrames;
+	bits->numWords = (numFrames + WORD_BITS - 1) / WORD_BITS;
+	bits->nextFree = 0;
+	bits->numDirty = 0;
+
+	bits->allocated = allocBitmap(bits->numWords);
+	bits->reference = allocBitmap(bits->numWords);
+	bits->dirty = allocBitmap(bits->numWords);
+	bits->busy = allocBitmap(bits->numWords);
+	bits->active = allocBitmap(bits->numWords);
+}
+
+// Frees the bitmaps
+void freeFrameBits(FrameBits * bits){
+	free(bits->allocated);
+	free(bits->reference);
+	free(bits->dirty);
+	free(bits->busy);
+	free(bits->active);
+}
+
+// Sets the frame's bit in the bitmap
+void setFrameBit(uint64_t * bitmap, int frameNum){
+	bitmap[frameNum / WORD_BITS] |= 1UL << (frameNum % WORD_BITS);
+}
+
+// Clears the frame's bit in the bitmap
+void clearFrameBit(uint64_t * bitmap, int frameNum){
+	bitmap[frameNum / WORD_BITS] &= ~(1UL << (frameNum % WORD_BITS));
+}
+
+// Returns the frame's bit in the bitmap
+bool testFrameBit(const uint64_t * bitmap, int frameNum){
+	return bitmap[frameNum / WORD_BITS] >> (frameNum % WORD_BITS) & 1UL;
+}
+
+// Returns the first free frame at or after the last one found, or -1 if none
+int findFreeFrame(FrameBits * bits){
+	int word = bits->nextFree / WORD_BITS;
+	uint64_t startMask = ~0UL << (bits->nextFree % WORD_BITS);
+	uint64_t candidates;
+	int i;
+
+	// Checks each word once, and the first word's low bits again at the end
+	for (i = 0; i <= bits->numWords; i++){
+		candidates = ~bits->allocated[word] & validMask(bits, word)
+			     & startMask;
+
+		if (candidates != 0){
+			bits->nextFree = word * WORD_BITS
+					 + __builtin_ctzl(candidates);
+			return bits->nextFree;
+		}
+
+		startMask = ~0UL;
+		word = (word + 1) % bits->numWords;
+	}
+
+	return -1;
+}
+
+// Moves the hand to the first allocated, unreferenced frame at or after it
+// that is not being paged in, clearing the reference bits it passes, and
+// returns that frame or -1
+int sweepClock(FrameBits * bits, int * hand){
+	return sweep(bits, hand, bits->reference, NULL);
+}
+
+// Moves the hand to the first dirty frame at or after it that is not being
+// paged in and was not referenced since the hand last passed it, clearing
+// the active bits it passes, and returns that frame or -1
+int sweepDirty(FrameBits * bits, int * hand){
+	return sweep(bits, hand, bits->active, bits->dirty);
+}
+
+// Sets the dirty bit of a frame, counting it if it was clean
+void markDirty(FrameBits * bits, int frameNum){
+	if (testFrameBit(bits->dirty, frameNum)) return;
+
+	setFrameBit(bits->dirty, frameNum);
+	bits->numDirty++;
+}
+
+// Clears the dirty bit of a frame, counting it if it was dirty
+void markClean(FrameBits * bits, int frameNum){
+	if (!testFrameBit(bits->dirty, frameNum)) return;
+
+	clearFrameBit(bits->dirty, frameNum);
+	bits->numDirty--;
+}
+
+// Moves the hand to the first allocated frame at or after it that is not
+// being paged in, has its bit in required set if required is not NULL, and
+// has its bit in chances clear, clearing the bits in chances it passes, and
+// returns that frame or -1
+static int sweep(FrameBits * bits, int * hand, uint64_t * chances,
+		 const uint64_t * required){
+	int word = *hand / WORD_BITS;
+	uint64_t passed = ~0UL << (*hand % WORD_BITS) & validMask(bits, word);
+	uint64_t candidates;
+	int i;
+
+	// Every chance bit is clear after one pass, so two always suffice
+	for (i = 0; i <= 2 * bits->numWords; i++){
+		candidates = bits->allocated[word] & ~chances[word]
+			     & ~bits->busy[word] & passed;
+		if (required != NULL) candidates &= required[word];
+
+		if (candidates != 0){
+
+			// Clears the bits passed before reaching the frame
+			passed &= (candidates & -candidates) - 1;
+			chances[word] &= ~passed;
+
+			*hand = word * WORD_BITS + __builtin_ctzl(candidates);
+			return *hand;
+		}
+
+		// Clears the chance bits of every frame in the word passed
+		chances[word] &= ~passed;
+
+		word = (word + 1) % bits->numWords;
+		passed = validMask(bits, word);
+	}
+
+	return -1;
+}
+
+// Allocates a bitmap with every bit clear or exits with an error message
+static uint64_t * allocBitmap(int numWords){
+	uint64_t * bitmap;
+
+	if ((bitmap = calloc(numWords, sizeof(uint64_t))) == NULL)
+		perrorExit("Failed to allocate frame bitmap");
+
+	return bitmap;
+}
+
+// Returns a mask of the bits in the word that correspond to real frames
+static uint64_t validMask(const FrameBits * bits, int word){
+	int remaining = bits->numFrames - word * WORD_BITS;
+
+	return remaining >= WORD_BITS ? ~0UL : (1UL << remaining) - 1;
+}
@@ -0,0 +1,40 @@
+// frameBits.h was created by Mark Renard on 5/11/2020.
+//
+// This file defines packed bitmaps, parallel to the frame table, recording
+// which frames are allocated, referenced recently, dirty, and being paged
+// in. Keeping the bits out of the frame descriptors lets free frames, clock
+// victims, and dirty frames to clean be found 64 frames at a time.
+
+#ifndef FRAMEBITS_H
+#define FRAMEBITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define WORD_BITS 64	// Frames per bitmap word
+
+typedef struct frameBits {
+	uint64_t * allocated;	// Whether each frame is allocated to a page
+	uint64_t * reference;	// Whether each frame was referenced recently
+	uint64_t * dirty;	// Whether each frame was written since loaded
+	uint64_t * busy;	// Whether each frame's page is being read in
+	uint64_t * active;	// Whether each frame was referenced since the
+				// pageout daemon's hand passed it
+	int numFrames;		// Number of frames
+	int numWords;		// Words in each bitmap
+	int nextFree;		// Frame at which to start looking for a free one
+	int numDirty;		// Frames with the dirty bit set
+} FrameBits;
+
+void initFrameBits(FrameBits * bits, int numFrames);
+void freeFrameBits(FrameBits * bits);
+void setFrameBit(uint64_t * bitmap, int frameNum);
+void clearFrameBit(uint64_t * bitmap, int frameNum);
+bool testFrameBit(const uint64_t * bitmap, int frameNum);
+int findFreeFrame(FrameBits * bits);
+int sweepClock(FrameBits * bits, int * hand);
+int sweepDirty(FrameBits * bits, int * hand);
+void markDirty(FrameBits * bits, int frameNum);
+void markClean(FrameBits * bits, int frameNum);
+
+#endif
@@ -6,12 +6,10 @@
 #include "constants.h"
 #include "frameDescriptor.h"
 
-void initFrameTable(FrameDescriptor * frameTable){
+void initFrameTable(FrameDescriptor * frameTable, int numFrames){
 	int i = 0;
-	for( ; i < NUM_FRAMES; i++){
-		frameTable[i].simPid = (char) EMPTY;
-		frameTable[i].pageNum = (char) EMPTY;
-		frameTable[i].reference = 0;
-		frameTable[i].dirty = 0;
+	for( ; i < numFrames; i++){
+		frameTable[i].simPid = EMPTY;
+		frameTable[i].pageNum = EMPTY;
 	}
 }
@@ -1,19 +1,18 @@
 // frameDescriptor.h was created by Mark Renard on 4/30/2020.
 //
 // This file contains the definition of a FrameDescriptor, which records
-// whether a frame was referenced recently or written to since its page was
-// last written to the disk. 
+// the process and page to which a frame is allocated. Whether the frame was
+// referenced recently or written to since its page was last written to the
+// disk is recorded in the bitmaps defined in frameBits.h.
 
 #ifndef FRAMEDESCRIPTOR_H
 #define FRAMEDESCRIPTOR_H
 
 typedef struct frameDescriptor{
-	signed char simPid;	// simPid of the process to which the frame is allocated
-	signed char pageNum;	// pageNum corresponding to the frame in the page table
-	char reference;		// Whether the frame was referenced recently
-	char dirty;		// Whether frame was written to since last disk write
+	int simPid;		// simPid of the process to which the frame is allocated
+	int pageNum;		// pageNum corresponding to the frame in the page table
 } FrameDescriptor;
 
-void initFrameTable(FrameDescriptor * frameTable);
+void initFrameTable(FrameDescriptor * frameTable, int numFrames);
 
 #endif
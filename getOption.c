@@ -1,22 +1,115 @@
 // getOption.c was created by Mark Renard on 5/4/2020.
 //
-// This file defines a function wich returns 1 or 0, depending on what the user
-// entered as an optarg for -m.
+// This file defines a function which fills an Options struct with the values
+// the user entered on the command line, including 1 or 0 for -m. Options can
+// also be given by name, as lines of name = value in a file read with -C or
+// as name=value with -o, and each option takes the last value given.
 
+#include "getOption.h"
 #include "perrorExit.h"
 #include "constants.h"
 
+#include <ctype.h>
+#include <limits.h>
+#include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 
+// Names an option that can be set in a config file or with -o
+typedef struct optionName {
+	const char * name;	// Name given in a file or with -o
+	int option;		// Letter of the option on the command line
+} OptionName;
+
+// Prototypes
+static void setOption(int option, char * value, Options * options);
+static void setNamedOption(const char * name, char * value,
+			   Options * options);
+static void readConfigFile(const char * path, Options * options);
+static char * trim(char * text);
+static bool flagValue(char * value);
+
+// Constants
+static const OptionName OPTION_NAMES[] = {
+	{"weighted", 'm'}, {"rings", 'r'}, {"batchSize", 'b'},
+	{"inProcess", 'p'}, {"maxRunning", 'n'}, {"maxLaunched", 't'},
+	{"frames", 'f'}, {"maxPages", 'a'}, {"seed", 's'}, {"policy", 'P'},
+	{"record", 'w'}, {"replay", 'T'}, {"tlbEntries", 'l'},
+	{"tlbWays", 'k'}, {"tlbFlushes", 'F'}, {"tlbRandom", 'R'},
+	{"export", 'H'}, {"log", 'L'}, {"pageSize", 'z'},
+	{"readProbability", 'q'}, {"ioTime", 'i'}, {"memoryTime", 'e'},
+	{"diskChannels", 'd'}, {"storage", 'D'}, {"diskSchedule", 'S'},
+	{"pageoutLow", 'u'}, {"pageoutHigh", 'U'}, {"freeMin", 'M'},
+	{"freeLow", 'g'}, {"freeHigh", 'G'}, {"readAhead", 'A'}
+};
+static const int NUM_OPTION_NAMES = sizeof(OPTION_NAMES)
+				    / sizeof(OptionName);
 
 // Prints usage message on incorrect usage and exits
 static void printUsageExit(){
 	fprintf(stderr, "\nusage: \n\t%s -m 0 for unweighted "
 		"addresss\n\t%s -m 1 for weighted address "
-		"selection\n", exeName, exeName);
+		"selection\n\noptions:\n"
+		"\t-r\tpass references through shared memory rings\n"
+		"\t-b n\tsend references in batches of n (1 to %d)\n"
+		"\t-p\tsimulate processes inside oss without forking\n"
+		"\t-n n\trun at most n processes at once (default %d)\n"
+		"\t-t n\tlaunch n processes in total (default %d)\n"
+		"\t-f n\tsimulate n frames of main memory (default %d)\n"
+		"\t-a n\tallocate up to n pages to a process (default %d)\n"
+		"\t-s n\tseed the pseudorandom number generator with n\n"
+		"\t-P name\treplace pages with fifo, lru, clock (default),\n"
+		"\t\tclockpro, arc, or opt (requires -T)\n"
+		"\t-w file\trecord each reference processed in file\n"
+		"\t-T file\treplay the references recorded in file (requires"
+		" -p)\n"
+		"\t-l n\tcache n translations in the tlb, 0 for none "
+		"(default %d)\n"
+		"\t-k n\tuse n entries per tlb set, dividing -l (default %d)\n"
+		"\t-F\tflush the tlb on process switches instead of tagging"
+		" entries\n"
+		"\t-R\treplace tlb entries at random instead of lru\n"
+		"\t-H file\texport access time percentiles and histograms to"
+		" file,\n\t\tas JSON if it ends in .json or CSV otherwise\n"
+		"\t-L file\twrite the log to file (default %s)\n"
+		"\t-z n\tuse pages of n bytes (default %d)\n"
+		"\t-q p\tmake reads with probability p (default %g)\n"
+		"\t-i n\ttake n ns to read or write a page on disk "
+		"(default %d)\n"
+		"\t-e n\ttake n ns to access main memory (default %d)\n"
+		"\t-d n\tpage up to n faults at once, at most -f "
+		"(default: set by -D)\n"
+		"\t-D name\tmodel the disk as flat (default, every transfer "
+		"taking -i),\n\t\thdd, ssd, or nvme\n"
+		"\t-S name\tstart queued faults in fifo (default), sstf, "
+		"scan, or clook order\n"
+		"\t-u n\tclean dirty frames in the background when fewer than"
+		" n are clean\n"
+		"\t-U n\tstop cleaning once n frames are clean (default %d "
+		"times -u)\n"
+		"\t-g n\tkeep a pool of free frames, reclaiming frames into it"
+		" when\n\t\tfewer than n are free\n"
+		"\t-G n\tstop reclaiming once n frames are free (default %d "
+		"times -g)\n"
+		"\t-M n\tmake faults evict their own victims when n or fewer"
+		" frames\n\t\tare free (default 0)\n"
+		"\t-A n\tread up to n pages ahead of faults a constant stride"
+		" apart\n\t\tinto free frames (1 to %d, default none)\n"
+		"\t-C file\tread options from lines of name = value in file\n"
+		"\t-o name=value\tset an option by name\n\n"
+		"names:\n\tweighted rings batchSize inProcess maxRunning "
+		"maxLaunched frames\n\tmaxPages seed policy record replay "
+		"tlbEntries tlbWays tlbFlushes\n\ttlbRandom export log pageSize "
+		"readProbability ioTime memoryTime\n\tdiskChannels storage "
+		"diskSchedule pageoutLow pageoutHigh\n\tfreeMin freeLow "
+		"freeHigh readAhead\n",
+		exeName, exeName, MAX_BATCH_SIZE, MAX_RUNNING, MAX_LAUNCHED,
+		NUM_FRAMES, MAX_ALLOC_PAGES, TLB_ENTRIES, TLB_WAYS,
+		LOG_FILE_NAME, PAGE_SIZE, READ_PROBABILITY, IO_OPERATION_NS,
+		MEM_ACCESS_NS, PAGEOUT_HIGH_FACTOR, FREE_HIGH_FACTOR,
+		MAX_READ_AHEAD);
 	exit(1);
 }
 
@@ -25,31 +118,411 @@ static int invalidOptarg(char * optarg){
 	return strcmp("0", optarg) != 0 && strcmp("1", optarg) != 0;
 }
 
-// Returns the optarg the user enters after argument -m or exits with usage msg
-char * getOption(int argc, char * argv[]){
+// True if optarg is not an integer in the range [min, max]
+static int invalidIntOptarg(char * optarg, int min, int max){
+	char * end;
+	long value = strtol(optarg, &end, 10);
+
+	return *optarg == '\0' || *end != '\0' || value < min || value > max;
+}
+
+// True if optarg is not a number in the range [min, max]
+static int invalidDoubleOptarg(char * optarg, double min, double max){
+	char * end;
+	double value = strtod(optarg, &end);
+
+	return *optarg == '\0' || *end != '\0' || value < min || value > max;
+}
+
+// Sets options to the values the user entered or exits with usage msg
+void getOptions(int argc, char * argv[], Options * options){
+	char * value;	// Value following the = of -o
 	int option;
-	char * arg = NULL;
+
+	// Sets defaults
+	options->weighted = NULL;
+	options->useRings = false;
+	options->batchSize = "1";
+	options->inProcess = false;
+	options->maxRunning = MAX_RUNNING;
+	options->maxLaunched = MAX_LAUNCHED;
+	options->numFrames = NUM_FRAMES;
+	options->maxPages = MAX_ALLOC_PAGES;
+	options->seeded = false;
+	options->policy = &CLOCK_POLICY;
+	options->recordPath = NULL;
+	options->replayPath = NULL;
+	options->tlbEntries = TLB_ENTRIES;
+	options->tlbWays = TLB_WAYS;
+	options->tlbFlushes = false;
+	options->tlbRandom = false;
+	options->exportPath = NULL;
+	options->logPath = LOG_FILE_NAME;
+	options->pageSize = PAGE_SIZE;
+	options->readProbability = READ_PROBABILITY;
+	options->ioTime = TIME(IO_OPERATION_SEC, IO_OPERATION_NS);
+	options->memoryTime = TIME(MEM_ACCESS_SEC, MEM_ACCESS_NS);
+	options->diskChannels = 0;
+	options->storage = &FLAT_STORAGE;
+	options->diskSchedule = FIFO_SCHEDULE;
+	options->pageoutLow = 0;
+	options->pageoutHigh = 0;
+	options->freeMin = 0;
+	options->freeLow = 0;
+	options->freeHigh = 0;
+	options->readAhead = 0;
 
 	// Retreives options, checking for invalid arguments
-	while((option = getopt(argc, argv, "m:")) != -1){
+	while((option = getopt(argc, argv, "m:rb:pn:t:f:a:s:P:w:T:l:k:FRH:L:"
+			       "z:q:i:e:d:D:S:u:U:g:G:M:A:C:o:")) != -1){
 		switch (option){
-		case 'm':
+		case 'C':
+			readConfigFile(optarg, options);
+			break;
 
-			// Prints usage message and exits if optarg invalid
-			if (invalidOptarg(optarg)) printUsageExit();
+		case 'o':
+			if ((value = strchr(optarg, '=')) == NULL)
+				printUsageExit();
+			*value = '\0';
+			setNamedOption(optarg, value + 1, options);
+			break;
 
-			// Copies optarg
-			arg = optarg;	
+		// Passes no value for flags, which getopt leaves optarg for
+		case 'r':
+		case 'p':
+		case 'F':
+		case 'R':
+			setOption(option, NULL, options);
 			break;
 
-		default:
+		case '?':
 			printUsageExit();
+
+		default:
+			setOption(option, optarg, options);
 		}
 	}
 
 	// Prints usage message and exits if no valid optarg entered
-	if (arg == NULL) printUsageExit();
-	
-	return arg;
+	if (options->weighted == NULL) printUsageExit();
+
+	// Prints usage message and exits if a trace is needed but not replayed
+	if (options->policy->needsTrace && options->replayPath == NULL)
+		printUsageExit();
+	if (options->replayPath != NULL && !options->inProcess)
+		printUsageExit();
+
+	// Prints usage message and exits if tlb sets would be uneven
+	if (options->tlbEntries % options->tlbWays != 0)
+		printUsageExit();
+
+	// Prints usage message and exits if there are more channels than
+	// frames to page into, which also limits the storage model's default
+	if (options->diskChannels > options->numFrames)
+		printUsageExit();
+	if (options->diskChannels == 0)
+		options->diskChannels = options->storage->queueDepth
+					< options->numFrames
+					? options->storage->queueDepth
+					: options->numFrames;
+
+	// Prints usage message and exits if the watermarks are out of order or
+	// more than the frames, defaulting the high one to a multiple of -u
+	if (options->pageoutHigh == 0)
+		options->pageoutHigh = options->pageoutLow * PAGEOUT_HIGH_FACTOR
+				       < options->numFrames
+				       ? options->pageoutLow
+					 * PAGEOUT_HIGH_FACTOR
+				       : options->numFrames;
+	if (options->pageoutLow > options->pageoutHigh
+	    || options->pageoutHigh > options->numFrames)
+		printUsageExit();
+
+	// Prints usage message and exits if the free pool's watermarks are out
+	// of order or more than the frames, defaulting the high one as above
+	if (options->freeHigh == 0)
+		options->freeHigh = options->freeLow * FREE_HIGH_FACTOR
+				    < options->numFrames
+				    ? options->freeLow * FREE_HIGH_FACTOR
+				    : options->numFrames;
+	if (options->freeLow > 0 && options->freeMin >= options->freeLow)
+		printUsageExit();
+	if (options->freeLow > options->freeHigh
+	    || options->freeHigh > options->numFrames)
+		printUsageExit();
+
+	// Prints usage message and exits if addresses would overflow an int
+	if ((long) options->pageSize * options->maxPages > INT_MAX)
+		printUsageExit();
+}
+
+// Sets an option from its letter and value, which is NULL for flags given
+// on the command line, or exits with usage msg
+static void setOption(int option, char * value, Options * options){
+	int schedule;	// Index of a disk schedule
+
+	switch (option){
+	case 'm':
+
+		// Prints usage message and exits if value invalid
+		if (invalidOptarg(value)) printUsageExit();
+
+		// Copies value
+		options->weighted = value;
+		break;
+
+	case 'r':
+		options->useRings = flagValue(value);
+		break;
+
+	case 'b':
+		if (invalidIntOptarg(value, 1, MAX_BATCH_SIZE))
+			printUsageExit();
+
+		options->batchSize = value;
+		break;
+
+	case 'p':
+		options->inProcess = flagValue(value);
+		break;
+
+	case 'n':
+		if (invalidIntOptarg(value, 1, MAX_PROCESSES))
+			printUsageExit();
+
+		options->maxRunning = atoi(value);
+		break;
+
+	case 't':
+		if (invalidIntOptarg(value, 1, INT_MAX))
+			printUsageExit();
+
+		options->maxLaunched = atoi(value);
+		break;
+
+	case 'f':
+		if (invalidIntOptarg(value, 2, MAX_FRAMES))
+			printUsageExit();
+
+		options->numFrames = atoi(value);
+		break;
+
+	case 'a':
+		if (invalidIntOptarg(value, MIN_ALLOC_PAGES, MAX_PAGES))
+			printUsageExit();
+
+		options->maxPages = atoi(value);
+		break;
+
+	case 's':
+		if (invalidIntOptarg(value, 0, INT_MAX))
+			printUsageExit();
+
+		options->seeded = true;
+		options->seed = atoi(value);
+		break;
+
+	case 'P':
+		options->policy = getReplacementPolicy(value);
+		if (options->policy == NULL) printUsageExit();
+		break;
+
+	case 'w':
+		options->recordPath = value;
+		break;
+
+	case 'T':
+		options->replayPath = value;
+		break;
+
+	case 'l':
+		if (invalidIntOptarg(value, 0, MAX_TLB_ENTRIES))
+			printUsageExit();
+
+		options->tlbEntries = atoi(value);
+		break;
+
+	case 'k':
+		if (invalidIntOptarg(value, 1, MAX_TLB_ENTRIES))
+			printUsageExit();
+
+		options->tlbWays = atoi(value);
+		break;
+
+	case 'F':
+		options->tlbFlushes = flagValue(value);
+		break;
+
+	case 'R':
+		options->tlbRandom = flagValue(value);
+		break;
+
+	case 'H':
+		options->exportPath = value;
+		break;
+
+	case 'L':
+		options->logPath = value;
+		break;
+
+	case 'z':
+		if (invalidIntOptarg(value, 1, MAX_PAGE_SIZE))
+			printUsageExit();
+
+		options->pageSize = atoi(value);
+		break;
+
+	case 'q':
+		if (invalidDoubleOptarg(value, 0, 1))
+			printUsageExit();
+
+		options->readProbability = strtod(value, NULL);
+		break;
+
+	case 'i':
+		if (invalidIntOptarg(value, 0, INT_MAX))
+			printUsageExit();
+
+		options->ioTime = atoi(value);
+		break;
+
+	case 'e':
+		if (invalidIntOptarg(value, 0, INT_MAX))
+			printUsageExit();
+
+		options->memoryTime = atoi(value);
+		break;
+
+	case 'd':
+		if (invalidIntOptarg(value, 1, MAX_DISK_CHANNELS))
+			printUsageExit();
+
+		options->diskChannels = atoi(value);
+		break;
+
+	case 'D':
+		options->storage = getStorageModel(value);
+		if (options->storage == NULL) printUsageExit();
+		break;
+
+	case 'u':
+		if (invalidIntOptarg(value, 0, MAX_FRAMES))
+			printUsageExit();
+
+		options->pageoutLow = atoi(value);
+		break;
+
+	case 'U':
+		if (invalidIntOptarg(value, 1, MAX_FRAMES))
+			printUsageExit();
+
+		options->pageoutHigh = atoi(value);
+		break;
+
+	case 'g':
+		if (invalidIntOptarg(value, 0, MAX_FRAMES))
+			printUsageExit();
+
+		options->freeLow = atoi(value);
+		break;
+
+	case 'G':
+		if (invalidIntOptarg(value, 1, MAX_FRAMES))
+			printUsageExit();
+
+		options->freeHigh = atoi(value);
+		break;
+
+	case 'M':
+		if (invalidIntOptarg(value, 0, MAX_FRAMES))
+			printUsageExit();
+
+		options->freeMin = atoi(value);
+		break;
+
+	case 'A':
+		if (invalidIntOptarg(value, 0, MAX_READ_AHEAD))
+			printUsageExit();
+
+		options->readAhead = atoi(value);
+		break;
+
+	case 'S':
+		if ((schedule = getDiskSchedule(value)) == -1)
+			printUsageExit();
+
+		options->diskSchedule = schedule;
+		break;
+
+	default:
+		printUsageExit();
+	}
+}
+
+// Sets the option with a name to a value or exits with usage msg
+static void setNamedOption(const char * name, char * value,
+			   Options * options){
+	int i;
+
+	for (i = 0; i < NUM_OPTION_NAMES; i++)
+		if (strcmp(name, OPTION_NAMES[i].name) == 0){
+			setOption(OPTION_NAMES[i].option, value, options);
+			return;
+		}
+
+	fprintf(stderr, "%s: unknown option name %s\n", exeName, name);
+	printUsageExit();
+}
+
+// Sets options from lines of name = value in a file, skipping blank lines
+// and text following #
+static void readConfigFile(const char * path, Options * options){
+	FILE * file;
+	char line[BUFF_SZ];	// A line of the file
+	char * value;		// Value following the = of the line
+	char * comment;		// # starting a comment in the line or NULL
+	int lineNum = 0;
+
+	if ((file = fopen(path, "r")) == NULL)
+		perrorExit("Failed to open config file");
+
+	while (fgets(line, BUFF_SZ, file) != NULL){
+		lineNum++;
+		if ((comment = strchr(line, '#')) != NULL) *comment = '\0';
+		if (*trim(line) == '\0') continue;
+
+		if ((value = strchr(line, '=')) == NULL){
+			fprintf(stderr, "%s: %s:%d: expected name = value\n",
+				exeName, path, lineNum);
+			printUsageExit();
+		}
+		*value = '\0';
+
+		// Copies the value, since options point to their values
+		if ((value = strdup(trim(value + 1))) == NULL)
+			perrorExit("Failed to copy config value");
+		setNamedOption(trim(line), value, options);
+	}
+
+	fclose(file);
+}
+
+// Returns true for a flag given on the command line or set to 1 by name, or
+// false for one set to 0
+static bool flagValue(char * value){
+	if (value == NULL) return true;
+	if (invalidOptarg(value)) printUsageExit();
+
+	return strcmp(value, "1") == 0;
+}
+
+// Removes whitespace from the end of text and returns its first
+// non-whitespace character
+static char * trim(char * text){
+	char * end = text + strlen(text);
+
+	while (end > text && isspace((unsigned char) end[-1])) *--end = '\0';
+	while (isspace((unsigned char) *text)) text++;
 
+	return text;
 }
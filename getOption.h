@@ -1,11 +1,54 @@
 // getOption.h was created by Mark Renard on 5/4/2020.
 //
-// This file contains the function header for the getOption function in
-// assignment 6.
+// This file contains the definition of the options the user can set for oss
+// and the function header for the getOptions function in assignment 6.
 
 #ifndef GETOPTION_H
 #define GETOPTION_H
 
-char * getOption(int argc, char * argv[]);
+#include <stdbool.h>
+
+#include "clock.h"
+#include "disk.h"
+#include "replacementPolicy.h"
+
+typedef struct options {
+	char * weighted;	// "1" for weighted address selection, else "0"
+	bool useRings;		// Whether references are passed through rings
+	char * batchSize;	// References sent per request, "1" by default
+	bool inProcess;		// Whether oss generates references itself
+	int maxRunning;		// Max number of running processes
+	int maxLaunched;	// Max total processes launched
+	int numFrames;		// Number of frames in main memory
+	int maxPages;		// Max number of pages allocated to a process
+	bool seeded;		// Whether the user entered a seed
+	unsigned int seed;	// Seed for the pseudorandom number generator
+	const ReplacementPolicy * policy;	// Page replacement policy
+	char * recordPath;	// File references are recorded in or NULL
+	char * replayPath;	// File of references to replay or NULL
+	int tlbEntries;		// Entries in the tlb, or 0 for no tlb
+	int tlbWays;		// Entries in each set of the tlb
+	bool tlbFlushes;	// Whether the tlb is flushed on process switches
+	bool tlbRandom;		// Whether tlb victims are chosen at random
+	char * exportPath;	// File statistics are exported to or NULL
+	char * logPath;		// File the log is written to
+	int pageSize;		// Bytes in a page
+	double readProbability;	// Chance a reference is a read
+	Time ioTime;		// Time to read or write a page on disk
+	Time memoryTime;	// Time to access main memory
+	int diskChannels;	// Faults the disk can page at once
+	const StorageModel * storage;	// Model of the disk's latencies
+	DiskSchedule diskSchedule;	// Order queued faults are paged in
+	int pageoutLow;		// Clean frames below which dirty frames are
+				// cleaned, or 0 for no pageout daemon
+	int pageoutHigh;	// Clean frames at which cleaning stops
+	int freeMin;		// Free frames faults leave in the pool
+	int freeLow;		// Free frames below which frames are
+				// reclaimed, or 0 for no free pool
+	int freeHigh;		// Free frames at which reclaiming stops
+	int readAhead;		// Most pages read ahead of a fault, or 0
+} Options;
+
+void getOptions(int argc, char * argv[], Options * options);
 
 #endif
@@ -2,41 +2,102 @@
 // modified on 4/29/2020.
 //
 // This file contains the definition of a shared memory function specific to
-// assignment 6. This function is used by oss.c and userProgram.c.
+// assignment 6. This function is used by oss.c and userProgram.c. oss passes
+// the sizes of the shared arrays when it creates the region, and user
+// processes read them from the start of the region when they attach.
+
+#include <stddef.h>
 
 #include "clock.h"
 #include "constants.h"
+#include "getSharedMemoryPointers.h"
+#include "pageTable.h"
 #include "pcb.h"
 #include "protectedClock.h"
 #include "frameDescriptor.h"
+#include "referenceGen.h"
+#include "refRing.h"
 #include "sharedMemory.h"
 
-int getSharedMemoryPointers(char ** shm,  ProtectedClock ** systemClock,
-			     FrameDescriptor ** frameTable,
-			     PCB ** pcbs, double ** weights, int flags) {
+// Rounds a size up to a multiple of the cache line size
+#define LINE_ALIGN(size) \
+	(((size) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE)
+
+// Creates shared memory sized by newConfig, or attaches to the existing
+// region if newConfig is NULL, and gets pointers to each part of it
+size_t getSharedMemoryPointers(char ** shm, ShmConfig ** config,
+			       ProtectedClock ** systemClock,
+			       FrameDescriptor ** frameTable, PCB ** pcbs,
+			       PageTableArena ** pageTables, double ** weights,
+			       Doorbell ** doorbell, RefRing ** rings,
+			       const ShmConfig * newConfig){
+	const ShmConfig * sizes;	// Sizes of the shared arrays
+	size_t clockOffset;		// Offset of the system clock
+	size_t frameOffset;		// Offset of the frame table
+	size_t pcbOffset;		// Offset of the pcbs
+	size_t pageOffset;		// Offset of the page tables
+	size_t weightOffset;		// Offset of the weights
+	size_t ringOffset;		// Offset of the doorbell and rings
+	size_t shmSize;			// Size of the region
+
+	// Reads the sizes of the arrays from an existing region
+	if (newConfig == NULL){
+		*shm = sharedMemory(0, 0);
+		sizes = (ShmConfig *)(*shm);
+	}
+	else sizes = newConfig;
+
+	// Computes cache line aligned offset of each part of the region
+	clockOffset = LINE_ALIGN(sizeof(ShmConfig));
+	frameOffset = LINE_ALIGN(clockOffset + sizeof(ProtectedClock));
+	pcbOffset = LINE_ALIGN(frameOffset 
+			       + sizeof(FrameDescriptor) * sizes->numFrames);
+	pageOffset = LINE_ALIGN(pcbOffset + sizeof(PCB) * sizes->numPcbs);
+	weightOffset = LINE_ALIGN(pageOffset 
+				  + pageTableArenaSize(sizes->numPcbs,
+						       sizes->numFrames,
+						       sizes->maxPages));
+	ringOffset = LINE_ALIGN(weightOffset 
+				+ sizeof(double) * sizes->maxPages);
 
 	// Computes size of the shared memory region
-	int shmSize = sizeof(ProtectedClock) \
-		      + sizeof(FrameDescriptor) * NUM_FRAMES \
-                      + sizeof(PCB) * MAX_RUNNING \
-		      + sizeof(int) * MAX_ALLOC_PAGES;
+	shmSize = ringOffset + sizeof(Doorbell) 
+		  + sizeof(RefRing) * sizes->numPcbs;
+
+	// Creates shared memory and stores the sizes of its arrays
+	if (newConfig != NULL){
+		*shm = sharedMemory(shmSize, IPC_CREAT);
+		*(ShmConfig *)(*shm) = *newConfig;
+	}
 
- 	// Attaches to shared memory
-        *shm = sharedMemory(shmSize, flags);
+	// Gets pointer to the sizes of the arrays
+	*config = (ShmConfig *)(*shm);
 
 	// Gets pointer to simulated system clock
-	*systemClock = (ProtectedClock *)(*shm);
+	*systemClock = (ProtectedClock *)(*shm + clockOffset);
 
-	// Gets pointer to first resource descriptor
-	*frameTable = (FrameDescriptor *)(*shm + sizeof(ProtectedClock));
+	// Gets pointer to first frame descriptor
+	*frameTable = (FrameDescriptor *)(*shm + frameOffset);
 
-	// Gets pointer to message array
-	*pcbs = (PCB *)( ((char*)(*frameTable)) \
-		     + (sizeof(FrameDescriptor) * NUM_FRAMES));
+	// Gets pointer to pcb array
+	*pcbs = (PCB *)(*shm + pcbOffset);
+
+	// Gets pointer to page tables and lets pageTable.c find each tree
+	*pageTables = (PageTableArena *)(*shm + pageOffset);
+	setPageTables(*pageTables, (*config)->numPcbs, (*config)->numFrames,
+		      (*config)->maxPages);
+
+	// Lets referenceGen.c make references of the configured sizes
+	setReferenceGen((*config)->pageSize, (*config)->readProbability);
 
 	// Gets pointer to array of weights
-	*weights = (double *)(*pcbs + MAX_RUNNING);
+	*weights = (double *)(*shm + weightOffset);
+
+	// Gets pointer to doorbell
+	*doorbell = (Doorbell *)(*shm + ringOffset);
+
+	// Gets pointer to array of request rings
+	*rings = (RefRing *)(*doorbell + 1);
 
 	return shmSize;
 }
-
@@ -2,19 +2,36 @@
 // modified on 4/30/2020.
 //
 // This file contains a header for the function getSharedMemoryPointers to be
-// used in assignment 6.
+// used in assignment 6, along with the sizes of the shared arrays, which are
+// stored at the start of shared memory so user processes can find them.
 
 #ifndef GETSHAREDMEMORYPOINTERS_H
 #define GETSHAREDMEMORYPOINTERS_H
 
+#include <stddef.h>
+
 #include "constants.h"
+#include "pageTable.h"
 #include "pcb.h"
 #include "protectedClock.h"
 #include "frameDescriptor.h"
+#include "refRing.h"
 #include "sharedMemory.h"
 
-int getSharedMemoryPointers(char ** shm,  ProtectedClock ** systemClock,
-                            FrameDescriptor ** frameTable, PCB ** pcbs, 
-			    double ** weights, int flags);
+// Sizes of the arrays in shared memory and settings user processes need
+typedef struct shmConfig {
+	int numPcbs;	// Number of pcbs and request rings
+	int numFrames;	// Number of frames in main memory
+	int maxPages;	// Max number of pages allocated to a process
+	int pageSize;	// Bytes in a page
+	double readProbability;	// Chance a reference is a read
+} ShmConfig;
+
+size_t getSharedMemoryPointers(char ** shm, ShmConfig ** config,
+			       ProtectedClock ** systemClock,
+			       FrameDescriptor ** frameTable, PCB ** pcbs,
+			       PageTableArena ** pageTables, double ** weights,
+			       Doorbell ** doorbell, RefRing ** rings,
+			       const ShmConfig * newConfig);
 
 #endif
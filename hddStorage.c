@@ -0,0 +1,66 @@
+// hddStorage.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains a model of a hard disk with one head. Swap slots are
+// laid out HDD_SLOTS_PER_TRACK to a track, one track to a cylinder, in
+// order. A transfer waits for the head to finish earlier ones, seeks to the
+// slot's cylinder in time that grows linearly with the distance, waits for
+// the slot to rotate under the head, and reads or writes it in the time one
+// slot takes to pass. The platter turns continuously from time 0, so the
+// rotational delay depends on when the seek ends.
+
+#include "constants.h"
+#include "storageModel.h"
+
+// Prototypes
+static void hddInit(long numSlots, Time ioTime);
+static Time hddTransfer(long slot, bool write, Time now);
+
+const StorageModel HDD_STORAGE = {
+	"hdd", HDD_QUEUE_DEPTH, hddInit, hddTransfer
+};
+
+// Constants
+static const Time SLOT_TIME = HDD_ROTATION_NS / HDD_SLOTS_PER_TRACK;
+
+// Static global variables
+static long numCylinders;	// Cylinders holding every slot
+static long headCylinder;	// Cylinder the head is over
+static Time freeTime;		// Time the head finishes its last transfer
+
+// Starts the head idle over the first cylinder
+static void hddInit(long numSlots, Time ioTime){
+	numCylinders = (numSlots + HDD_SLOTS_PER_TRACK - 1)
+		       / HDD_SLOTS_PER_TRACK;
+	headCylinder = 0;
+	freeTime = 0;
+}
+
+// Returns the time until the slot has been read or written, moving the head
+static Time hddTransfer(long slot, bool write, Time now){
+	long cylinder = slot / HDD_SLOTS_PER_TRACK;	// Cylinder of the slot
+	long distance;		// Cylinders the head moves
+	long position;		// Slot under the head when the seek ends
+	Time start;		// Time the head starts seeking
+	Time seek;		// Time to move the head
+	Time rotation;		// Time for the slot to reach the head
+
+	start = now > freeTime ? now : freeTime;
+
+	// Seeks in time proportional to the distance, past a settling time
+	distance = cylinder > headCylinder ? cylinder - headCylinder
+					   : headCylinder - cylinder;
+	seek = 0;
+	if (distance > 0)
+		seek = HDD_MIN_SEEK_NS + (HDD_MAX_SEEK_NS - HDD_MIN_SEEK_NS)
+		       * (distance - 1) / (numCylinders > 1 ? numCylinders - 1
+							     : 1);
+
+	// Waits for the slot to come around
+	position = (start + seek) / SLOT_TIME % HDD_SLOTS_PER_TRACK;
+	rotation = (slot % HDD_SLOTS_PER_TRACK - position + HDD_SLOTS_PER_TRACK)
+		   % HDD_SLOTS_PER_TRACK * SLOT_TIME;
+
+	headCylinder = cylinder;
+	freeTime = start + seek + rotation + SLOT_TIME;
+	return freeTime - now;
+}
@@ -0,0 +1,121 @@
+// histogram.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains functions that record times in log-spaced histograms
+// and read percentiles back from them. Recording a value finds its bucket
+// from the position of its highest set bit, so it takes constant time and
+// never allocates. Values of HISTOGRAM_MAX_BITS bits or more are counted in
+// the last bucket, though the largest value is still kept exactly.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "histogram.h"
+#include "perrorExit.h"
+
+// Prototypes
+static int bucketIndex(const Histogram * histogram, Time value);
+
+// Allocates the buckets of an empty histogram
+void initHistogram(Histogram * histogram, int subBits){
+	histogram->subBits = subBits;
+	histogram->numBuckets = (HISTOGRAM_MAX_BITS - subBits + 1) << subBits;
+
+	histogram->counts = calloc(histogram->numBuckets, sizeof(uint64_t));
+	if (histogram->counts == NULL)
+		perrorExit("initHistogram failed to allocate buckets");
+
+	histogram->total = 0;
+	histogram->sum = 0;
+	histogram->max = 0;
+}
+
+// Frees the buckets of a histogram
+void freeHistogram(Histogram * histogram){
+	free(histogram->counts);
+	histogram->counts = NULL;
+}
+
+// Removes every value from a histogram
+void resetHistogram(Histogram * histogram){
+	memset(histogram->counts, 0, sizeof(uint64_t) * histogram->numBuckets);
+	histogram->total = 0;
+	histogram->sum = 0;
+	histogram->max = 0;
+}
+
+// Counts a value in its bucket
+void recordHistogram(Histogram * histogram, Time value){
+	histogram->counts[bucketIndex(histogram, value)]++;
+	histogram->total++;
+	histogram->sum += value;
+	if (value > histogram->max) histogram->max = value;
+}
+
+// Returns the highest value of the bucket holding the given percentile of
+// the values recorded, or 0 if there are none
+Time histogramPercentile(const Histogram * histogram, double percentile){
+	double exactRank;	// Rank of the percentile before rounding
+	uint64_t rank;		// Values at or below the percentile
+	uint64_t seen = 0;	// Values in the buckets checked so far
+	Time high;		// Highest value of the bucket
+	int i;
+
+	if (histogram->total == 0) return 0;
+
+	// Rounds the rank up to a whole value
+	exactRank = percentile / 100.0 * histogram->total;
+	rank = exactRank;
+	if (rank < exactRank || rank == 0) rank++;
+
+	for (i = 0; i < histogram->numBuckets; i++){
+		seen += histogram->counts[i];
+		if (seen >= rank) break;
+	}
+
+	high = bucketHigh(histogram, i);
+	return high < histogram->max ? high : histogram->max;
+}
+
+// Returns the mean of the values recorded, or 0 if there are none
+Time histogramMean(const Histogram * histogram){
+	if (histogram->total == 0) return 0;
+
+	return histogram->sum / histogram->total;
+}
+
+// Returns the lowest value counted in a bucket
+Time bucketLow(const Histogram * histogram, int bucket){
+	int shift;	// Bits of the value below those in the index
+
+	if (bucket < 1 << histogram->subBits) return bucket;
+
+	shift = (bucket >> histogram->subBits) - 1;
+	return ((Time) 1 << histogram->subBits
+		| (bucket & ((1 << histogram->subBits) - 1))) << shift;
+}
+
+// Returns the highest value counted in a bucket
+Time bucketHigh(const Histogram * histogram, int bucket){
+	int shift;	// Bits of the value below those in the index
+
+	if (bucket < 1 << histogram->subBits) return bucket;
+
+	shift = (bucket >> histogram->subBits) - 1;
+	return bucketLow(histogram, bucket) + ((Time) 1 << shift) - 1;
+}
+
+// Returns the index of the bucket counting a value, keeping the subBits bits
+// below its highest set bit
+static int bucketIndex(const Histogram * histogram, Time value){
+	int shift;	// Bits of the value below those in the index
+
+	if (value < (Time) 1 << histogram->subBits) return value;
+
+	if (value >= (Time) 1 << HISTOGRAM_MAX_BITS)
+		value = ((Time) 1 << HISTOGRAM_MAX_BITS) - 1;
+
+	shift = 63 - __builtin_clzll(value) - histogram->subBits;
+	return (shift + 1) << histogram->subBits
+	       | (value >> shift & ((1 << histogram->subBits) - 1));
+}
@@ -0,0 +1,34 @@
+// histogram.h was created by Mark Renard on 5/12/2020.
+//
+// This file defines a histogram of times in log-spaced buckets, in the style
+// of HdrHistogram. Values below 2^subBits nanoseconds have a bucket each, and
+// every power of two above that is split into 2^subBits buckets, so a value
+// is placed within 1 / 2^subBits of its size in constant time.
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+
+#include "clock.h"
+
+// Stores the counts of a histogram, allocated once when it is initialized
+typedef struct histogram {
+	int subBits;		// Bits of each value kept in its bucket index
+	int numBuckets;		// Length of counts
+	uint64_t * counts;	// Values recorded in each bucket
+	uint64_t total;		// Values recorded in all buckets
+	Time sum;		// Sum of the values recorded
+	Time max;		// Largest value recorded
+} Histogram;
+
+void initHistogram(Histogram * histogram, int subBits);
+void freeHistogram(Histogram * histogram);
+void resetHistogram(Histogram * histogram);
+void recordHistogram(Histogram * histogram, Time value);
+Time histogramPercentile(const Histogram * histogram, double percentile);
+Time histogramMean(const Histogram * histogram);
+Time bucketLow(const Histogram * histogram, int bucket);
+Time bucketHigh(const Histogram * histogram, int bucket);
+
+#endif
@@ -0,0 +1,84 @@
+// indexList.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains functions that add indices to the back of a list, remove
+// them from anywhere in a list, and take them from the front.
+
+#include <stdlib.h>
+
+#include "constants.h"
+#include "indexList.h"
+#include "replacementPolicy.h"
+
+// Allocates links for indices 0 to size - 1, none of which are in a list
+void initIndexPool(IndexPool * pool, int size){
+	int i;
+
+	pool->next = policyAlloc(sizeof(int) * size);
+	pool->previous = policyAlloc(sizeof(int) * size);
+	pool->list = policyAlloc(sizeof(int) * size);
+
+	for (i = 0; i < size; i++){
+		pool->next[i] = EMPTY;
+		pool->previous[i] = EMPTY;
+		pool->list[i] = EMPTY;
+	}
+}
+
+// Frees the links of a pool
+void freeIndexPool(IndexPool * pool){
+	free(pool->next);
+	free(pool->previous);
+	free(pool->list);
+}
+
+// Initializes an empty list
+void initIndexList(IndexList * list, int id){
+	list->front = EMPTY;
+	list->back = EMPTY;
+	list->count = 0;
+	list->id = id;
+}
+
+// Adds an index that is not in a list to the back of the list
+void pushBack(IndexList * list, IndexPool * pool, int index){
+	pool->next[index] = EMPTY;
+	pool->previous[index] = list->back;
+	pool->list[index] = list->id;
+
+	if (list->back == EMPTY)
+		list->front = index;
+	else
+		pool->next[list->back] = index;
+
+	list->back = index;
+	list->count++;
+}
+
+// Removes an index from the list containing it
+void removeIndex(IndexList * list, IndexPool * pool, int index){
+	int next = pool->next[index];
+	int previous = pool->previous[index];
+
+	if (previous == EMPTY)
+		list->front = next;
+	else
+		pool->next[previous] = next;
+
+	if (next == EMPTY)
+		list->back = previous;
+	else
+		pool->previous[next] = previous;
+
+	pool->list[index] = EMPTY;
+	list->count--;
+}
+
+// Removes and returns the front index of the list, or EMPTY if it is empty
+int popFront(IndexList * list, IndexPool * pool){
+	int index = list->front;
+
+	if (index != EMPTY)
+		removeIndex(list, pool, index);
+
+	return index;
+}
@@ -0,0 +1,33 @@
+// indexList.h was created by Mark Renard on 5/10/2020.
+//
+// This file defines doubly linked lists of integer indices whose links are
+// stored in a shared pool, so that an index can be moved between lists or
+// removed from the middle of one in constant time. Replacement policies use
+// them to order frames and the pages they remember.
+
+#ifndef INDEXLIST_H
+#define INDEXLIST_H
+
+// Links of every index that can be in a list
+typedef struct indexPool {
+	int * next;	// Index after each index, toward the back
+	int * previous;	// Index before each index, toward the front
+	int * list;	// Id of the list each index is in, or EMPTY
+} IndexPool;
+
+// A list of indices from a pool
+typedef struct indexList {
+	int front;	// Least recently added index or EMPTY
+	int back;	// Most recently added index or EMPTY
+	int count;	// Number of indices in the list
+	int id;		// Id stored in the pool for indices in this list
+} IndexList;
+
+void initIndexPool(IndexPool * pool, int size);
+void freeIndexPool(IndexPool * pool);
+void initIndexList(IndexList * list, int id);
+void pushBack(IndexList * list, IndexPool * pool, int index);
+void removeIndex(IndexList * list, IndexPool * pool, int index);
+int popFront(IndexList * list, IndexPool * pool);
+
+#endif
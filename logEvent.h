@@ -0,0 +1,45 @@
+// logEvent.h was created by Mark Renard on 5/11/2020.
+//
+// This file defines the fixed-size binary records oss appends to its log.
+// Each record holds the arguments of one line, or one row of the memory map,
+// and osslog renders the records as text. Text that is logged once, like the
+// final statistics, is copied into the records following a LOG_TEXT record.
+
+#ifndef LOGEVENT_H
+#define LOGEVENT_H
+
+#include <stdint.h>
+
+// Kinds of records, each rendered as one of the lines of the text log
+typedef enum logEventType {
+	LOG_TERMINATION,	// Time and eat of a process that terminated
+	LOG_READ_REQUEST,	// Process and address of a read request
+	LOG_READ_GRANTED,	// Address, frame, and process of a granted read
+	LOG_WRITE_REQUEST,	// Process and address of a write request
+	LOG_WRITE_GRANTED,	// Address, frame, and process of a granted write
+	LOG_PAGE_FAULT,		// Address that caused a page fault
+	LOG_SWAP,		// Frame, process, and page of a swap
+	LOG_DIRTY,		// Frame written back because it was dirty
+	LOG_RECLAIM,		// Frame, process, and page reclaimed, and
+				// whether it was dirty
+	LOG_READ_INDICATION,	// Process told a queued read was done
+	LOG_WRITE_INDICATION,	// Process told a queued write was done
+	LOG_MEMORY_MAP,		// Time at which the memory map is printed
+	LOG_PAGE_HEADER,	// Page numbers heading the page tables
+	LOG_PAGE_ROW,		// Valid bits of a page table of up to 64 pages
+	LOG_PAGE_COUNT,		// Resident pages of a wider page table
+	LOG_FRAME_HEADER,	// Column names heading the frame table
+	LOG_FRAME,		// Process, reference bit, and dirty bit of a frame
+	LOG_BLANK_LINE,		// An empty line ending a part of the memory map
+	LOG_TEXT		// Length of text stored in the following records
+} LogEventType;
+
+// One record of the log
+typedef struct logEvent {
+	uint64_t time;		// Simulated time of the event
+	uint64_t value;		// Eat of a termination or valid bits of a row
+	int32_t args[3];	// Numbers printed in the line, in order
+	uint32_t type;		// LogEventType of the record
+} LogEvent;
+
+#endif
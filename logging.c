@@ -1,94 +1,145 @@
 // logging.c was created by Mark Renard on 5/1/2020.
 //
 // This file contains definitions for functions that aid in the collection,
-// formatting, and logging of data pertinent to Assignment 6.
+// formatting, and logging of data pertinent to Assignment 6. Each line is
+// appended to a ring as a fixed-size binary record, and a writer thread
+// drains the ring to the log file in large writes, so oss never waits on the
+// file. osslog renders the records as text.
 
 #include "clock.h"
 #include "constants.h"
+#include "disk.h"
+#include "frameBits.h"
 #include "frameDescriptor.h"
+#include "histogram.h"
+#include "logEvent.h"
+#include "pageTable.h"
 #include "pcb.h"
 #include "perrorExit.h"
 #include "stats.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+// Prototypes
+static void appendEvent(LogEventType type, Time time, uint64_t value,
+			int32_t arg0, int32_t arg1, int32_t arg2);
+static void appendRecord(const LogEvent * event);
+static void logText(const char * format, ...);
+static void logPercentiles(const char * label, const Histogram * histogram,
+			   const char * end);
+static void * drainLog(void * arg);
+static bool writeEvents(unsigned long from, unsigned long to);
+
+// Static global variables
+static int log = -1;			// Descriptor of the log file or -1
+static int lines = 0;			// Lines the log renders to
+static LogEvent * ring = NULL;		// Records not yet written
+static pthread_t writer;		// Thread draining the ring
+static _Atomic unsigned long head \
+	__attribute__((aligned(CACHE_LINE_SIZE)));	// Records appended
+static _Atomic unsigned long tail \
+	__attribute__((aligned(CACHE_LINE_SIZE)));	// Records written
+static _Atomic bool closing;		// Whether the writer should finish
+static bool writeFailed = false;	// Whether a write to the log failed
+
+// Opens the log file at path and starts the thread writing to it, or exits
+// with an error message
+void openLogFile(const char * path){
+	sigset_t all, previous;	// Signals blocked in the writer, and before
+
+	if ((log = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644))
+	    == -1)
+		perrorExit("logging.c - failed to open log file");
 
-static FILE * log = NULL;
-static int lines = 0;
+	if (write(log, LOG_MAGIC, LOG_HEADER_SIZE) != LOG_HEADER_SIZE)
+		perrorExit("logging.c - failed to write log header");
 
-Clock MEM_ACCESS_TIME = {MEM_ACCESS_SEC, MEM_ACCESS_NS};
+	// Touches every page of the ring so that appends never fault
+	if ((ring = malloc(sizeof(LogEvent) * LOG_RING_EVENTS)) == NULL)
+		perrorExit("logging.c - failed to allocate log ring");
+	memset(ring, 0, sizeof(LogEvent) * LOG_RING_EVENTS);
 
-// Opens the log file with name LOG_FILE_NAME or exits with an error message
-void openLogFile(){
-	if ((log = fopen(LOG_FILE_NAME, "w+")) == NULL)
-		perrorExit("logging.c - failed to open log file");
+	atomic_store(&head, 0);
+	atomic_store(&tail, 0);
+	atomic_store(&closing, false);
+
+	// Leaves signals to the main thread, which oss's handlers expect
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &previous);
+	if (pthread_create(&writer, NULL, drainLog, NULL) != 0)
+		perrorExit("logging.c - failed to start log writer");
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
 }
 
-// Closes the log file
+// Waits for the writer to drain the ring and closes the log file
 void closeLogFile(){
-	if (log != NULL){
-		if (fclose(log) == -1)
-			perrorExit("logging.c - error closing log file");
-	}
-}
+	if (log == -1) return;
 
-// Logs when a process has terminated
-void logTermination(int simPid, Clock time, const PCB * pcb){
-	lines += 2;
-	if (lines > MAX_LOG_LINES) return;
+	atomic_store(&closing, true);
+	pthread_join(writer, NULL);
 
-	Clock eat = getEatFromPcb(pcb);
+	free(ring);
+	ring = NULL;
 
-	fprintf(log, "Master: P%d has terminated at time %03d : %09d\n",
-		simPid, time.seconds, time.nanoseconds);
+	if (close(log) == -1)
+		perrorExit("logging.c - error closing log file");
+	log = -1;
 
-	fprintf(log, "\t\t Effective memory access time: %03d : %09d\n",
-		eat.seconds, eat.nanoseconds);
+	if (writeFailed)
+		perrorExit("logging.c - failed to write log records");
+}
 
-	
+// Logs when a process has terminated
+void logTermination(int simPid, Time time, const PCB * pcb){
+	lines += 3;
+	if (lines > MAX_LOG_LINES) return;
+
+	appendEvent(LOG_TERMINATION, time, getEatFromPcb(pcb), simPid, 0, 0);
+	logPercentiles("\t\t Memory access time", getProcessHistogram(simPid),
+		       "\n");
 }
 
 // Logs a request to read from an address at a particular time
-void logReadRequest(int simPid, int address, Clock time){
+void logReadRequest(int simPid, int address, Time time){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: P%d requesting read of address %d at time "
-		"%03d : %09d\n", simPid, address, time.seconds, 
-		time.nanoseconds);
+	appendEvent(LOG_READ_REQUEST, time, 0, simPid, address, 0);
 }
 
 // Logs the granting of a request to read from an address
-void logReadGranted(int address, int frameNum, int simPid, Clock time){
+void logReadGranted(int address, int frameNum, int simPid, Time time){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: Address %d in frame %d, giving data to P%d at " \
-		"time %03d : %09d\n", address, frameNum, simPid, time.seconds,
-		time.nanoseconds);
+	appendEvent(LOG_READ_GRANTED, time, 0, address, frameNum, simPid);
 }
 
 // Logs a request to write to an address at a particular time
-void logWriteRequest(int simPid, int address, Clock time){
+void logWriteRequest(int simPid, int address, Time time){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: P%d requesting write of address %d at time " \
-		"%03d : %09d\n", simPid, address, time.seconds, 
-		time.nanoseconds);
-
+	appendEvent(LOG_WRITE_REQUEST, time, 0, simPid, address, 0);
 }
 
 // Logs the granting of a request to write to an address
-void logWriteGranted(int address, int frameNum, int simPid, Clock time){
+void logWriteGranted(int address, int frameNum, int simPid, Time time){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: Address %d in frame %d, writing data from P%d " \
-		"to frame at time %03d : %09d\n", address, frameNum, simPid, 
-		time.seconds, time.nanoseconds);
+	appendEvent(LOG_WRITE_GRANTED, time, 0, address, frameNum, simPid);
 }
 
 // Logs when a request was received by oss
-void logRequest(int simPid, Reference ref, Clock time){
-
-	// Tracks number of memory accesses
-	statsMemoryAccess();
-
+void logRequest(int simPid, Reference ref, Time time){
 	if (ref.type == READ_REFERENCE)
 		logReadRequest(simPid, ref.address, time);
 	else
@@ -96,13 +147,8 @@ void logRequest(int simPid, Reference ref, Clock time){
 }
 
 // Logs when a request is immediately granted by oss
-void logGrantedRequest(Reference ref, unsigned char frameNum, int simPid,
-		       Clock time){
-
-	// Tracks total memory access time
-	Clock diff = clockDiff(time, ref.startTime); 
-	statsAddMemoryAccessTime(diff);
-
+void logGrantedRequest(Reference ref, int frameNum, int simPid,
+		       Time time){
 	if (ref.type == READ_REFERENCE){
 		logReadGranted(ref.address, frameNum, simPid, time);
 	} else {
@@ -114,53 +160,47 @@ void logGrantedRequest(Reference ref, unsigned char frameNum, int simPid,
 void logPageFault(int address){
 	if (++lines > MAX_LOG_LINES) return;
 
-	// Tracks page faults
-	statsPageFault();
-
-	fprintf(log, "Master: Address %d is not in a frame, pagefault\n", 
-		address);
-
+	appendEvent(LOG_PAGE_FAULT, 0, 0, address, 0, 0);
 }
 
 // Logs swapping in of a page
 void logSwap(int frameNum, int simPid, int pageNum){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: Clearing frame %d and swapping in P%d page %d\n",
-		frameNum, simPid, pageNum);	
+	appendEvent(LOG_SWAP, 0, 0, frameNum, simPid, pageNum);
 }
 
 // Logs that a frame was dirty
 void logDirty(int frameNum){
 	if (++lines > MAX_LOG_LINES) return;
 	
-	fprintf(log, "Master: Dirty bit of frame %d was set, adding " \
-		"additional time to the clock\n", frameNum);
+	appendEvent(LOG_DIRTY, 0, 0, frameNum, 0, 0);
+}
+
+// Logs that a frame was reclaimed into the free pool, and whether it is
+// written back first
+void logReclaim(int frameNum, int simPid, int pageNum, bool dirty){
+	if (++lines > MAX_LOG_LINES) return;
+
+	appendEvent(LOG_RECLAIM, 0, dirty, frameNum, simPid, pageNum);
 }
 
 // Logs that a queued read request fulfillment was indicated to a process
 void logReadIndication(int simPid, int address){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: Indicating to P%d that data can be read from " \
-		"address %d\n", simPid, address);
+	appendEvent(LOG_READ_INDICATION, 0, 0, simPid, address, 0);
 }
 
 // Logs that a queued write request fulfillment was indicated to a process
 void logWriteIndication(int simPid, int address){
 	if (++lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "Master: Indicating to P%d that write has happened to " \
-		"address %d\n", simPid, address);
+	appendEvent(LOG_WRITE_INDICATION, 0, 0, simPid, address, 0);
 }
 
 // Logs that a queued read or wite reference was fulfilled
 void logGrantedQueuedRequest(int simPid, Reference ref){
-
-	// Tracks memory access time
-	Clock diff = clockDiff(ref.endTime, ref.startTime); 
-	statsAddMemoryAccessTime(diff);
-
 	if (ref.type == READ_REFERENCE)
 		logReadIndication(simPid, ref.address);
 	else
@@ -169,82 +209,280 @@ void logGrantedQueuedRequest(int simPid, Reference ref){
 
 
 // Prints a representation of the page table of each process to teh log
-void logPages(const PCB * pcbs){
-	if (lines + MAX_RUNNING + 2 > MAX_LOG_LINES) return;
+void logPages(const PCB * pcbs, int numPcbs){
+	if (lines + numPcbs + 2 > MAX_LOG_LINES) return;
+	uint64_t validBits;	// Bit j is set if page j of a row is valid
+	int rowPages;		// Pages drawn in a row
 	int i, j;
 
-	// Prints frame numbers in header
-	fprintf(log, "\n     ");
-	for (j = 0; j < MAX_ALLOC_PAGES; j++)
-		fprintf(log, "%2d ", j);
-	fprintf(log, "\n");
+	// Prints page numbers in header if page tables fit across the log
+	appendEvent(LOG_PAGE_HEADER, 0, 0,
+		    getMaxPages() <= MAX_MAP_PAGES ? getMaxPages() : 0, 0, 0);
 	lines += 2;
 
 	// Prints one row per process
-	for (i = 0; i < MAX_RUNNING; i++){
+	for (i = 0; i < numPcbs; i++){
 
 		// Skips if the process is not running
 		if (pcbs[i].realPid == EMPTY) continue;
 
-		// Prints a row
-		fprintf(log, "P%2d: ", i);
-
-		for (j = 0; j < MAX_ALLOC_PAGES; j++){
-			if (j < pcbs[i].lengthRegister){
-				if (pcbs[i].pageTable[j].valid)
-					fprintf(log, " + ");
-				else
-					fprintf(log, " . ");
-			}
+		// Counts resident pages if the page table is too wide to print
+		if (getMaxPages() > MAX_MAP_PAGES){
+			appendEvent(LOG_PAGE_COUNT, 0, 0, i,
+				    countResidentPages(i),
+				    pcbs[i].lengthRegister);
+			lines++;
+			continue;
 		}
-		fprintf(log, "\n");
+
+		// Prints a row of the valid bits of the process's pages
+		rowPages = pcbs[i].lengthRegister < getMaxPages() ?
+			   pcbs[i].lengthRegister : getMaxPages();
+		validBits = 0;
+		for (j = 0; j < rowPages; j++)
+			if (lookupPage(i, j)->valid)
+				validBits |= (uint64_t) 1 << j;
+
+		appendEvent(LOG_PAGE_ROW, 0, validBits, i, rowPages, 0);
 		lines++;
 	}
-	fprintf(log, "\n");
+	appendEvent(LOG_BLANK_LINE, 0, 0, 0, 0, 0);
 	lines++;	
 	
 }
 
 // Prints a representation of frame data to the log
-void logFrames(const FrameDescriptor * frameTable){
-	if (lines + NUM_FRAMES + 2 > MAX_LOG_LINES) return;
-	lines += NUM_FRAMES + 2;
+void logFrames(const FrameDescriptor * frameTable, const FrameBits * bits){
+	if (lines + bits->numFrames + 2 > MAX_LOG_LINES) return;
+	lines += bits->numFrames + 2;
 
-	fprintf(log, "\t\tProcess\tRefByte\tDirtyBit\n");
+	appendEvent(LOG_FRAME_HEADER, 0, 0, 0, 0, 0);
 
 	int i;
-	for (i = 0; i < NUM_FRAMES; i++){
-		fprintf(log, "Frame %03d:\t%d\t%d\t%d\n", i, 
-			(int)frameTable[i].simPid,
-			(int)frameTable[i].reference, 
-			(int)frameTable[i].dirty);
+	for (i = 0; i < bits->numFrames; i++){
+		appendEvent(LOG_FRAME, 0, testFrameBit(bits->dirty, i), i,
+			    frameTable[i].simPid,
+			    testFrameBit(bits->reference, i));
 	}
-	fprintf(log, "\n");
+	appendEvent(LOG_BLANK_LINE, 0, 0, 0, 0, 0);
 }
 
 // Prints the memory map of the system to the log
-void logMemoryMap(const PCB * pcbs, const FrameDescriptor * frameTable,
-		  Clock time){
+void logMemoryMap(const PCB * pcbs, int numPcbs,
+		  const FrameDescriptor * frameTable, const FrameBits * bits,
+		  Time time){
 	lines += 2;
 	if (lines > MAX_LOG_LINES) return;
 
-	fprintf(log, "\nCurrent memory layout at time %03d : %09d is:\n",
-		time.seconds, time.nanoseconds);
+	appendEvent(LOG_MEMORY_MAP, time, 0, 0, 0, 0);
 
-	logPages(pcbs);
-	logFrames(frameTable);
+	logPages(pcbs, numPcbs);
+	logFrames(frameTable, bits);
 }
 
 
 // Logs memory access statistics
-void logStats(Clock time){
+void logStats(Time time){
 	Stats stats = getStats(time);
 
-	fprintf(log, "Number of memory accesses per second: %Lf\n" \
+	logText("Number of memory accesses per second: %Lf\n" \
 		"Number of page faults per memory access: %Lf\n" \
-		"Average memory access speed: %Lf seconds per access",
+		"TLB hit rate: %Lf, shootdowns: %lu, flushes: %lu\n" \
+		"Average address translation time: %.3Le seconds\n" \
+		"Average memory access speed: %.6Le seconds per access\n" \
+		"Page hits: %lu, faults: %lu, evictions: %lu, " \
+		"dirty write-backs: %lu\n" \
+		"Average paging queue wait: %Lf seconds\n" \
+		"Faults serviced per second: %Lf, average faults paging at " \
+		"once: %Lf, frames written back at once: %Lf\n" \
+		"Pageouts: %lu, write-backs saved: %lu, wasted: %lu, fault " \
+		"time saved: %Lf seconds\n" \
+		"Direct reclaims: %lu, background reclaims: %lu\n" \
+		"Pages read ahead: %lu, used: %lu, wasted: %lu, accuracy: " \
+		"%Lf, coverage: %Lf",
 		stats.memoryAccessesPerSecond,
 		stats.pageFaultsPerMemoryAccess,
-		stats.averageMemoryAccessSpeed);
+		stats.tlbHitRate, getStatCount(STAT_TLB_SHOOTDOWNS),
+		getStatCount(STAT_TLB_FLUSHES),
+		stats.averageTranslationTime,
+		stats.averageMemoryAccessSpeed,
+		getStatCount(STAT_PAGE_HITS), getStatCount(STAT_PAGE_FAULTS),
+		getStatCount(STAT_EVICTIONS),
+		getStatCount(STAT_DIRTY_WRITE_BACKS),
+		stats.averageQueueWait, stats.faultsServicedPerSecond,
+		stats.averageDiskQueueDepth, stats.averageBackgroundWrites,
+		getStatCount(STAT_PAGEOUTS),
+		getStatCount(STAT_PAGEOUT_SAVES),
+		getStatCount(STAT_WASTED_PAGEOUTS),
+		timeToSeconds(getStatCount(STAT_PAGEOUT_SAVED_TIME)),
+		getStatCount(STAT_DIRECT_RECLAIMS),
+		getStatCount(STAT_BACKGROUND_RECLAIMS),
+		getStatCount(STAT_PREFETCHES), getStatCount(STAT_PREFETCH_HITS),
+		getStatCount(STAT_WASTED_PREFETCHES), stats.prefetchAccuracy,
+		stats.prefetchCoverage);
+
+	// Logs the distributions of access and queue wait times
+	logPercentiles("\nHit access time",
+		       getStatHistogram(HIST_HIT_ACCESS), "");
+	logPercentiles("\nFault access time",
+		       getStatHistogram(HIST_FAULT_ACCESS), "");
+	logPercentiles("\nDirty fault access time",
+		       getStatHistogram(HIST_DIRTY_FAULT_ACCESS), "");
+	logPercentiles("\nPaging queue wait",
+		       getStatHistogram(HIST_QUEUE_WAIT), "");
+
+	// Logs the cost of page table walks at each level
+	int level;
+	for (level = 0; level < getPageTableDepth(); level++)
+		logText("\nLevel %d page table entries read per memory " \
+			"access: %Lf, walks ended: %ld", level,
+			stats.pageTableReadsPerMemoryAccess[level],
+			getLevelMisses(level));
+}
+
+// Logs the faults each disk channel serviced, the frames it cleaned, and the
+// share of the run it spent busy
+void logDisk(const Disk * disk, Time time){
+	int i;
+
+	logText("\nDisk: %s storage, %s scheduling, channels: %d",
+		disk->model->name, diskScheduleName(disk->schedule),
+		disk->numChannels);
+	for (i = 0; i < disk->numChannels; i++)
+		logText("\nDisk channel %d: faults serviced: %lu, frames "
+			"cleaned: %lu, busy: %Lf%%", i,
+			disk->channels[i].transfers, disk->channels[i].pageouts,
+			time == 0 ? 0 : (long double) disk->channels[i].busyTime
+					* 100 / time);
+}
+
+// Logs the percentiles of a histogram of times in nanoseconds
+static void logPercentiles(const char * label, const Histogram * histogram,
+			   const char * end){
+	logText("%s (ns): p50 %lu, p90 %lu, p99 %lu, p99.9 %lu, max %lu%s",
+		label, histogramPercentile(histogram, 50),
+		histogramPercentile(histogram, 90),
+		histogramPercentile(histogram, 99),
+		histogramPercentile(histogram, 99.9), histogram->max, end);
 }
 
+// Appends a record of the arguments of a line to the ring
+static void appendEvent(LogEventType type, Time time, uint64_t value,
+			int32_t arg0, int32_t arg1, int32_t arg2){
+	LogEvent event = {time, value, {arg0, arg1, arg2}, type};
+
+	appendRecord(&event);
+}
+
+// Copies a record into the ring, waiting for the writer if the ring is full
+static void appendRecord(const LogEvent * event){
+	unsigned long next = atomic_load_explicit(&head, memory_order_relaxed);
+
+	if (ring == NULL) return;
+
+	while (next - atomic_load_explicit(&tail, memory_order_acquire)
+	       == LOG_RING_EVENTS)
+		sched_yield();
+
+	ring[next & (LOG_RING_EVENTS - 1)] = *event;
+	atomic_store_explicit(&head, next + 1, memory_order_release);
+}
+
+// Formats text and appends it to the ring after a LOG_TEXT record
+static void logText(const char * format, ...){
+	char text[LOG_TEXT_SIZE];	// The formatted text
+	LogEvent chunk;			// Record holding part of the text
+	va_list args;
+	int length;
+	int i;
+
+	va_start(args, format);
+	length = vsnprintf(text, LOG_TEXT_SIZE, format, args);
+	va_end(args);
+	if (length >= LOG_TEXT_SIZE) length = LOG_TEXT_SIZE - 1;
+
+	appendEvent(LOG_TEXT, 0, 0, length, 0, 0);
+
+	// Copies the text into as many records as it fills
+	for (i = 0; i < length; i += sizeof(LogEvent)){
+		memset(&chunk, 0, sizeof(LogEvent));
+		memcpy(&chunk, text + i, length - i < (int) sizeof(LogEvent) ?
+					 length - i : (int) sizeof(LogEvent));
+		appendRecord(&chunk);
+	}
+}
+
+// Writes records from the ring to the log file until the log is closed
+static void * drainLog(void * arg){
+	const struct timespec idle = {0, LOG_POLL_NS};	// Sleep when empty
+	unsigned long written;	// Records written
+	unsigned long appended;	// Records appended
+
+	written = atomic_load_explicit(&tail, memory_order_relaxed);
+	for (;;){
+		appended = atomic_load_explicit(&head, memory_order_acquire);
+
+		// Sleeps if the ring is empty, or finishes once oss is closing
+		// the log and no record was appended before it started to
+		if (appended == written){
+			if (atomic_load(&closing)){
+				if (atomic_load(&head) == written) break;
+				continue;
+			}
+			nanosleep(&idle, NULL);
+			continue;
+		}
+
+		if (!writeFailed && !writeEvents(written, appended))
+			writeFailed = true;
+
+		written = appended;
+		atomic_store_explicit(&tail, written, memory_order_release);
+	}
+
+	return NULL;
+}
+
+// Writes the records from index from up to index to in one system call,
+// returning false if the write failed
+static bool writeEvents(unsigned long from, unsigned long to){
+	struct iovec parts[2];	// Records before and after the ring wraps
+	unsigned long first = from & (LOG_RING_EVENTS - 1);
+	unsigned long count = to - from;
+	unsigned long beforeWrap;
+	size_t bytes;
+	ssize_t bytesWritten;
+	int numParts = 1;
+
+	beforeWrap = LOG_RING_EVENTS - first < count ?
+		     LOG_RING_EVENTS - first : count;
+
+	parts[0].iov_base = &ring[first];
+	parts[0].iov_len = beforeWrap * sizeof(LogEvent);
+	if (beforeWrap < count){
+		parts[1].iov_base = &ring[0];
+		parts[1].iov_len = (count - beforeWrap) * sizeof(LogEvent);
+		numParts = 2;
+	}
+
+	// Writes the rest if the log file accepts part of the records
+	bytes = count * sizeof(LogEvent);
+	while (bytes > 0){
+		if ((bytesWritten = writev(log, parts, numParts)) <= 0)
+			return false;
+
+		bytes -= bytesWritten;
+		while (numParts > 0 && bytesWritten >= parts[0].iov_len){
+			bytesWritten -= parts[0].iov_len;
+			parts[0] = parts[1];
+			numParts--;
+		}
+		if (numParts > 0){
+			parts[0].iov_base = (char *) parts[0].iov_base
+					    + bytesWritten;
+			parts[0].iov_len -= bytesWritten;
+		}
+	}
+
+	return true;
+}
@@ -6,37 +6,39 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include "disk.h"
 #include "pcb.h"
+#include "frameBits.h"
 #include "frameDescriptor.h"
 #include "clock.h"
 
-// Opens the log file with name LOG_FILE_NAME or exits with an error message
-void openLogFile();
+// Opens the log file at path or exits with an error message
+void openLogFile(const char * path);
 
 // Closes the log file
 void closeLogFile();
 
 // Logs when a process has terminated
-void logTermination(int simPid, Clock time, const PCB * pcb);
+void logTermination(int simPid, Time time, const PCB * pcb);
 
 // Logs when a request was received by oss
-void logRequest(int simPid, Reference ref, Clock time);
+void logRequest(int simPid, Reference ref, Time time);
 
 // Logs when a request is immediately granted by oss
-void logGrantedRequest(Reference ref, unsigned char frameNum, int simPid,
-		       Clock time);
+void logGrantedRequest(Reference ref, int frameNum, int simPid,
+		       Time time);
 
 // Logs a request to read from an address at a particular time
-void logReadRequest(int simPid, int address, Clock time);
+void logReadRequest(int simPid, int address, Time time);
 
 // Logs the granting of a request to read from an address
-void logReadGranted(int address, int frameNum, int simPid, Clock time);
+void logReadGranted(int address, int frameNum, int simPid, Time time);
 
 // Logs a request to write to an address at a particular time
-void logWriteRequest(int simPid, int address, Clock time);
+void logWriteRequest(int simPid, int address, Time time);
 
 // Logs the granting of a request to write to an address
-void logWriteGranted(int address, int frameNum, int simPid, Clock time);
+void logWriteGranted(int address, int frameNum, int simPid, Time time);
 
 // Logs a page fault event
 void logPageFault(int address);
@@ -46,6 +48,7 @@ void logSwap(int frameNum, int simPid, int pageNum);
 
 // Logs that a frame was dirty
 void logDirty(int frameNum);
+void logReclaim(int frameNum, int simPid, int pageNum, bool dirty);
 
 // Logs that a queued read request fulfillment was indicated to a process
 void logReadIndication(int simPid, int address);
@@ -57,15 +60,21 @@ void logWriteIndication(int simPid, int address);
 void logGrantedQueuedRequest(int simPid, Reference ref);
 
 // Prints a representation of the page table of each process to teh log
-void logPages(const PCB * pcbs);
+void logPages(const PCB * pcbs, int numPcbs);
 
 // Prints a representation of frame data to the log
-void logFrames(const FrameDescriptor * frameTable);
+void logFrames(const FrameDescriptor * frameTable, const FrameBits * bits);
 
 // Prints the memory map of the system to the log
-void logMemoryMap(const PCB * pcbs, FrameDescriptor * frameTable, Clock time);
+void logMemoryMap(const PCB * pcbs, int numPcbs,
+		  const FrameDescriptor * frameTable, const FrameBits * bits,
+		  Time time);
 
 // Logs memory access statistics
-void logStats(Clock time);
+void logStats(Time time);
+
+// Logs the faults each disk channel serviced, the frames it cleaned, and the
+// time it was busy
+void logDisk(const Disk * disk, Time time);
 
 #endif
@@ -0,0 +1,55 @@
+// lruPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains exact least recently used page replacement. Frames are
+// kept in a list ordered by their last reference, which every reference moves
+// to the back.
+
+#include "constants.h"
+#include "indexList.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static void lruInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace);
+static void lruAllocate(int frameNum, PageKey key);
+static void lruReference(int frameNum, PageKey key);
+static int lruEvict(PageKey key);
+static void lruFree(int frameNum);
+
+const ReplacementPolicy LRU_POLICY = {
+	"lru", lruInit, lruAllocate, lruReference, lruEvict, lruFree, false
+};
+
+// Static global variables
+static IndexPool pool;	// Links between frames
+static IndexList recency;// Allocated frames from least to most recently used
+
+// Starts with no frames allocated
+static void lruInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace){
+	initIndexPool(&pool, numFrames);
+	initIndexList(&recency, 0);
+}
+
+// Adds the frame as the most recently used
+static void lruAllocate(int frameNum, PageKey key){
+	pushBack(&recency, &pool, frameNum);
+}
+
+// Moves a referenced resident frame to the most recently used position
+static void lruReference(int frameNum, PageKey key){
+	if (frameNum == EMPTY) return;
+
+	removeIndex(&recency, &pool, frameNum);
+	pushBack(&recency, &pool, frameNum);
+}
+
+// Evicts the least recently used frame
+static int lruEvict(PageKey key){
+	return popFront(&recency, &pool);
+}
+
+// Removes the frame from the list
+static void lruFree(int frameNum){
+	removeIndex(&recency, &pool, frameNum);
+}
@@ -0,0 +1,124 @@
+// optPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains Belady's optimal page replacement, which evicts the
+// frame whose page will be referenced furthest in the future. The future is
+// read from a recorded trace whose references are being replayed, so each
+// process's references are known exactly. Since paging delays change how the
+// references of different processes interleave, pages are compared by where
+// their next references fell in the recorded run.
+
+#include <limits.h>
+
+#include "constants.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static void optInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace);
+static void optAllocate(int frameNum, PageKey key);
+static void optReference(int frameNum, PageKey key);
+static int optEvict(PageKey key);
+static void optFree(int frameNum);
+
+const ReplacementPolicy OPT_POLICY = {
+	"opt", optInit, optAllocate, optReference, optEvict, optFree, true
+};
+
+#define NEVER LONG_MAX	// Next use of a page that is not referenced again
+
+// Static global variables
+static const Trace * future;	// The trace being replayed
+static long * nextSame;		// Index of the next record with the same page
+static long * nextUse;		// Index of the next reference to each page
+static long * referencesSeen;	// References made so far by each process
+static long * keyStart;		// Index in nextUse of each process's page 0
+static long * frameKey;		// Index in nextUse of each frame's page
+static int frameCount;		// Number of frames
+
+// Links each record of the trace to the next reference to the same page
+static void optInit(FrameBits * frameBits, int numFrames,
+		    const Trace * trace){
+	long numKeys;	// Number of pages referenced in the trace
+	long page;	// Index in nextUse of the page referenced by a record
+	long i;
+
+	future = trace;
+	frameCount = numFrames;
+
+	// Packs the pages of each process into consecutive slots of nextUse
+	keyStart = policyAlloc(sizeof(long) * (trace->numProcesses + 1));
+	keyStart[0] = 0;
+	for (i = 0; i < trace->numProcesses; i++)
+		keyStart[i + 1] = keyStart[i] + trace->lengthRegisters[i];
+	numKeys = keyStart[trace->numProcesses];
+
+	nextSame = policyAlloc(sizeof(long) * (trace->length + 1));
+	nextUse = policyAlloc(sizeof(long) * (numKeys + 1));
+	referencesSeen = policyAlloc(sizeof(long)
+				     * (trace->numProcesses + 1));
+	frameKey = policyAlloc(sizeof(long) * numFrames);
+
+	for (i = 0; i <= numKeys; i++)
+		nextUse[i] = NEVER;
+
+	for (i = 0; i < trace->numProcesses; i++)
+		referencesSeen[i] = 0;
+
+	for (i = 0; i < numFrames; i++)
+		frameKey[i] = EMPTY;
+
+	// Walks the trace backward, tracking the next use of each page
+	for (i = trace->length - 1; i >= 0; i--){
+		page = keyStart[trace->records[i].processNum]
+		       + trace->records[i].address / trace->pageSize;
+		nextSame[i] = nextUse[page];
+		nextUse[page] = i;
+	}
+}
+
+// Records which page is in the frame
+static void optAllocate(int frameNum, PageKey key){
+	if (keyProcess(key) < future->numProcesses)
+		frameKey[frameNum] = keyStart[keyProcess(key)] + keyPage(key);
+
+	// Uses the last slot, never referenced, for a process not recorded
+	else
+		frameKey[frameNum] = keyStart[future->numProcesses];
+}
+
+// Looks up when the page will next be referenced after this reference
+static void optReference(int frameNum, PageKey key){
+	int processNum = keyProcess(key);
+	long index;
+
+	// Returns if the process has made more references than were recorded
+	if (processNum >= future->numProcesses
+	    || referencesSeen[processNum]
+	       >= future->processStart[processNum + 1]
+		  - future->processStart[processNum])
+		return;
+
+	index = future->positions[future->processStart[processNum]
+				  + referencesSeen[processNum]++];
+	nextUse[keyStart[processNum] + keyPage(key)] = nextSame[index];
+}
+
+// Evicts the frame whose page will be referenced furthest in the future,
+// skipping frames whose pages are still being read in
+static int optEvict(PageKey key){
+	int victim = EMPTY;
+	int i;
+
+	for (i = 0; i < frameCount; i++)
+		if (frameKey[i] != EMPTY && (victim == EMPTY
+		    || nextUse[frameKey[i]] > nextUse[frameKey[victim]]))
+			victim = i;
+
+	frameKey[victim] = EMPTY;
+	return victim;
+}
+
+// Forgets the page in the frame
+static void optFree(int frameNum){
+	frameKey[frameNum] = EMPTY;
+}
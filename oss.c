@@ -2,22 +2,32 @@
 //
 // This program simulates memory management.
 
-#include "bitVector.h"
 #include "clock.h"
+#include "disk.h"
+#include "eventHeap.h"
 #include "getOption.h"
 #include "getSharedMemoryPointers.h"
 #include "logging.h"
+#include "pageout.h"
+#include "readAhead.h"
+#include "reclaim.h"
+#include "pageTable.h"
 #include "pcb.h"
+#include "frameBits.h"
 #include "frameDescriptor.h"
 #include "perrorExit.h"
 #include "protectedClock.h"
 #include "qMsg.h"
 #include "queue.h"
 #include "randomGen.h"
+#include "referenceGen.h"
+#include "refRing.h"
+#include "replacementPolicy.h"
 #include "stats.h"
+#include "tlb.h"
+#include "trace.h"
 
 #include <errno.h>
-#include <pthread.h>
 #include <stdio.h>
 #include <signal.h>
 #include <stdbool.h>
@@ -31,144 +41,302 @@
 
 // Prototypes
 static void simulateMemoryManagement();
+static void handleEvent(Event event);
 static void launchUserProcess();
-static int messageReceived(int*, int*);
+static void makeReferences(int simPid);
+static void resumeReferences(int simPid);
+static bool processContinues(int simPid);
+static int messageReceived(int*, RefBatch*);
+static void sendReply(int simPid);
 static void processTermination(int simPid);
 static void deallocateFrames(PCB * pcb);
-static void processReference(int simPid, Queue * q);
+static void processBatch(int simPid, Queue * q);
+static bool processReference(int simPid, Queue * q);
 static void checkPagingQueue(Queue * q);
-static void allocateFrame(int frameNum, PCB * pcb);
+static void completePaging(int simPid, Queue * q);
+static void reclaimFrame();
+static void startReclaimWrites();
+static void cleanFrame(int frameNum);
+static int evictFrame(PCB * pcb, int pageNum, long * victimSlot);
+static int reserveReadAhead(PCB * pcb, int * pages, int * frames,
+			    long * victimSlots);
+static int framesPagingIn();
+static void reserveFrame(int frameNum, int simPid, int pageNum,
+			 bool referenced);
 static void deallocateFrame(int frameNum);
-static int selectVictim();
-static void grantRequest(int simPid);
+static void grantRequest(int simPid, Time translationTime);
+static Time translate(int simPid, int pageNum, int * frameNum);
+static Time missTime(int levelsRead);
 static void initWeights(double * weights);
 static void waitForProcess(pid_t realPid);
 static void assignSignalHandlers();
+static void wakeOnChildExit(int param);
 static void cleanUpAndExit(int param);
 static void cleanUp();
 
 // Constants
-static const Clock MIN_FORK_TIME = {MIN_FORK_TIME_SEC, MIN_FORK_TIME_NS};
-static const Clock MAX_FORK_TIME = {MAX_FORK_TIME_SEC, MAX_FORK_TIME_NS};
+static const Time MIN_FORK_TIME = TIME(MIN_FORK_TIME_SEC, MIN_FORK_TIME_NS);
+static const Time MAX_FORK_TIME = TIME(MAX_FORK_TIME_SEC, MAX_FORK_TIME_NS);
 
-static const Clock IO_OP_TIME = {IO_OPERATION_SEC, IO_OPERATION_NS};
-static const Clock MEM_ACCESS_TIME = {MEM_ACCESS_SEC, MEM_ACCESS_NS};
+static const Time TLB_ACCESS_TIME = TIME(TLB_ACCESS_SEC, TLB_ACCESS_NS);
 
-static const Clock MEM_INT = {
-	MEM_MAP_PRINT_INTERVAL_SEC, MEM_MAP_PRINT_INTERVAL_NS
-};
+static const Time CLOCK_UPDATE = TIME(CLOCK_UPDATE_SEC, CLOCK_UPDATE_NS);
+
+static const Time MEM_INT = TIME(MEM_MAP_PRINT_INTERVAL_SEC,
+				 MEM_MAP_PRINT_INTERVAL_NS);
 
 // Static global variables
 static char * shm;			// Pointer to shared memory
+static ShmConfig * config;		// Sizes of the shared arrays
 static ProtectedClock * systemClock;	// Shared memory system clock
 static FrameDescriptor * frameTable;	// Shared memory frame table
+static FrameBits frameBits;		// Allocated, reference & dirty bits
+static PageTableArena * pageTables;	// Pool of page table nodes
 static PCB * pcbs;			// Shared process control blocks
 static double * weights;		// Shared array of page num weights
+static Doorbell * doorbell;		// Shared doorbell rung on requests
+static RefRing * rings;			// Shared request rings, one per pcb
+
+static int requestMqId = EMPTY;	// Id of message queue for requests & release
+static int replyMqId = EMPTY;	// Id of message queue for replies from oss
 
-static int requestMqId;	// Id of message queue for resource requests & release
-static int replyMqId;	// Id of message queue for replies from oss
+static Options options;	// Options entered by the user
+static bool weighted;	// Whether address selection is weighted
+static int batchSize;	// References per batch made by in-process processes
+static ReferenceGen * gens;	// Generators of processes simulated in oss
+static Trace trace;		// References replayed with -T
 
-static char * weighted;	// Indicates weighted address distribution if non-zero
+static EventHeap events;	// Scheduled forks, I/O completions, and prints
+static Queue q;			// Queue of processes waiting for paging I/O
+static Disk disk;		// Channels paging the faults started
+static int running = 0;		// Currently running process count
+static int launched = 0;	// Total processes launched
 
 int main(int argc, char * argv[]){
-	alarm(MAX_EXEC_SECONDS);// Sets maximum real execution time
+	ShmConfig newConfig;	// Sizes of the regions of shared memory
+
 	exeName = argv[0];	// Assigns exeName for perrorExit
 	assignSignalHandlers(); // Sets response to ctrl + C & alarm
-	openLogFile();		// Opens file written to in logging.c
 
-	srand(time(NULL) + BASE_SEED);   // Seeds pseudorandom number generator
+	// Gets user-entered options, including whether to weight references
+	getOptions(argc, argv, &options);
+	openLogFile(options.logPath);	// Opens file written to in logging.c
+	weighted = strcmp(options.weighted, "1") == 0;
+	batchSize = atoi(options.batchSize);
+
+	// Sets maximum real execution time if child processes could hang
+	if (!options.inProcess)
+		alarm(MAX_EXEC_SECONDS);
+
+	// Seeds pseudorandom number generator
+	srand(options.seeded ? options.seed : time(NULL) + BASE_SEED);
+
+	// Loads a trace to replay, launching each process it recorded
+	if (options.replayPath != NULL){
+		loadTrace(&trace, options.replayPath, options.pageSize);
+		options.maxLaunched = trace.numProcesses;
+
+		// Makes page tables large enough for every recorded page
+		if (options.maxPages < trace.maxLengthRegister)
+			options.maxPages = trace.maxLengthRegister;
+	}
+
+	// Creates shared memory region sized by the options and gets pointers
+	newConfig.numPcbs = options.maxRunning;
+	newConfig.numFrames = options.numFrames;
+	newConfig.maxPages = options.maxPages;
+	newConfig.pageSize = options.pageSize;
+	newConfig.readProbability = options.readProbability;
+	getSharedMemoryPointers(&shm, &config, &systemClock, &frameTable,
+				&pcbs, &pageTables, &weights, &doorbell, &rings,
+				&newConfig);
+
+	// Allocates reference generators if processes are simulated in oss
+	if (options.inProcess){
+		gens = malloc(sizeof(ReferenceGen) * options.maxRunning);
+		if (gens == NULL)
+			perrorExit("Failed to allocate reference generators");
+	}
 
-	// Gets user-entered option that determines whether to weight references
-	weighted = getOption(argc, argv);
+	// Creates message queues unless references are passed through rings
+	else if (!options.useRings){
+		requestMqId = getMessageQueue(REQUEST_MQ_KEY, 
+					      MQ_PERMS | IPC_CREAT);
+		replyMqId = getMessageQueue(REPLY_MQ_KEY, MQ_PERMS | IPC_CREAT);
+	}
 
-	// Creates shared memory region and gets pointers
-	getSharedMemoryPointers(&shm, &systemClock, &frameTable, &pcbs, 
-				&weights, IPC_CREAT);
+	// Allocates histograms, including one for each pcb's process
+	initStats(options.maxRunning);
 
-        // Creates message queues
-        requestMqId = getMessageQueue(REQUEST_MQ_KEY, MQ_PERMS | IPC_CREAT);
-        replyMqId = getMessageQueue(REPLY_MQ_KEY, MQ_PERMS | IPC_CREAT);
+	// Opens a file to record references in
+	if (options.recordPath != NULL)
+		openTraceFile(options.recordPath, options.pageSize);
 
-	// Initializes system clock and shared array of pcbs
+	// Initializes system clock, doorbell, and shared array of pcbs
 	initPClock(systemClock);
-	initPcbArray(pcbs);
-	initFrameTable(frameTable);
+	initDoorbell(doorbell);
+	initPcbArray(pcbs, options.maxRunning);
+	initPageTables();
+	initFrameTable(frameTable, config->numFrames);
+	initFrameBits(&frameBits, config->numFrames);
+	options.policy->init(&frameBits, config->numFrames, &trace);
+
+	// Creates the tlb unless it was disabled
+	if (options.tlbEntries > 0)
+		initTlb(options.tlbEntries, options.tlbWays, options.tlbFlushes,
+			options.tlbRandom);
 
 	// Initializes array of weights if option set
-	if (strcmp(weighted, "1") == 0)
+	if (weighted)
 		initWeights(weights);
 	
+	// Creates the disk paging faults, with a swap slot for every page a
+	// process launched can be allocated
+	options.storage->init((long) options.maxLaunched * options.maxPages,
+			      options.ioTime);
+	initDisk(&disk, options.diskChannels, options.storage,
+		 options.diskSchedule, options.maxPages, options.pageSize);
+	initPageout(config->numFrames, options.pageoutLow,
+		    options.pageoutHigh);
+	initReclaim(config->numFrames, options.freeMin, options.freeLow,
+		    options.freeHigh);
+	initReadAhead(options.maxRunning, config->numFrames, options.readAhead);
+
 	// Generates processes and simulates paging 
 	simulateMemoryManagement();
 
-	// Prints statistics to log file
+	// Prints statistics to log file and exports their distributions
 	logStats(getPTime(systemClock));
+	logDisk(&disk, getPTime(systemClock));
+	freeDisk(&disk);
+	freePageout();
+	freeReclaim();
+	freeReadAhead();
+	if (options.exportPath != NULL)
+		exportStats(options.exportPath);
+	freeStats();
+
+	if (options.replayPath != NULL)
+		freeTrace(&trace);
 
 	cleanUp();
 
 	return 0;
 }
 
-// Generates processes, grants requests, and resolves deadlock in a loop
+// Generates processes, grants requests, and handles events in a loop
 void simulateMemoryManagement(){
-	Clock timeToFork = zeroClock();	// Time to launch user process 
-	Clock timeToPrint = MEM_INT;	// Time to print memory map
-	Queue  q;			// Queue of requesting processes
-
-	int running = 0;		// Currently running child count
-	int launched = 0;		// Total children launched
-	int msg;			// Int representation of a msg
+	RefBatch batch;			// Received batch of requests
 	int senderSimPid;		// simPid of message sender
+	int received;			// Batches received in this loop
+	unsigned int rings;		// Doorbell rings before checking
 
 	initializeQueue(&q);
 
+	// Schedules the first launch and memory map print
+	initEventHeap(&events);
+	scheduleEvent(&events, 0, FORK_EVENT, EMPTY);
+	scheduleEvent(&events, MEM_INT, PRINT_EVENT, EMPTY);
+
 	// Launches processes, grants or enqueues requests, allocates pages
 	do {
 
-		// Launches user processes at random times if within limits
-		if (clockCompare(getPTime(systemClock), timeToFork) >= 0){
-			 
-			// Launches process if within limits
-			if (running < MAX_RUNNING && launched < MAX_LAUNCHED){
-				launchUserProcess();
+		// Handles every event scheduled at or before the current time
+		while (eventDue(&events, getPTime(systemClock)))
+			handleEvent(popEvent(&events));
 
-				running++;
-				launched++;
-			}
-
-			// Selects new random time to launch a new user process
-			incrementClock(&timeToFork, randomTime(MIN_FORK_TIME,
-							       MAX_FORK_TIME));
-		}
+		// Reads the doorbell before checking for requests
+		rings = doorbellRings(doorbell);
 
-		// Checks message queue for messages
-		while (messageReceived(&senderSimPid, &msg)){
+		// Checks message queue for messages from child processes
+		received = 0;
+		while (!options.inProcess 
+		       && messageReceived(&senderSimPid, &batch)){
+			received++;
 
 			// If process terminated, waits for it and frees memory
-			if (msg == TERMINATE){
+			if (batch.msgs[0].op == TERMINATE_MSG){
 				processTermination(senderSimPid);
 				running--;
 			}
 
-			// Grants or enqueues request for memory reference
-			else processReference(senderSimPid, &q);
+			// Grants or enqueues requests for memory references
+			else {
+				setBatchInPcb(&pcbs[senderSimPid], &batch);
+				processBatch(senderSimPid, &q);
+			}
 		}
 
-		// Increments system clock when all processes are waiting
-		if (q.count == running)
-			incrementPClock(systemClock, IO_OP_TIME);
-
-		// Performs the clock replacement algorithm 
+		// Starts paging I/O for the queue on each idle channel
 		checkPagingQueue(&q);
 
-		// Prints the memory map if interval reached
-		Clock now = getPTime(systemClock);
-		if (clockCompare(timeToPrint, now) <= 0){
-			logMemoryMap(pcbs, frameTable, now);
-			incrementClock(&timeToPrint, MEM_INT);
+		// Stops the clock at the last termination, so that the run does
+		// not end at the next event, such as a memory map print
+		if (running == 0 && launched == options.maxLaunched)
+			break;
+
+		// Advances the clock to the next event when all processes wait
+		// or when every process is simulated in oss
+		if (options.inProcess || q.count + disk.inFlight == running)
+			advancePClock(systemClock, peekEvent(&events)->time);
+
+		// Sleeps until a process sends a request or exits if there was
+		// nothing to do and some process is still making references
+		else if (received == 0)
+			waitForDoorbell(doorbell, rings);
+
+	} while ((running > 0 || launched < options.maxLaunched));
+
+	freeEventHeap(&events);
+	free(gens);
+}
+
+// Launches a process, completes paging I/O, prints the memory map, or makes
+// references for a process simulated in oss
+static void handleEvent(Event event){
+	switch (event.type){
+	case FORK_EVENT:
+
+		// Launches process if within limits
+		if (running < options.maxRunning 
+		    && launched < options.maxLaunched){
+			launchUserProcess();
+
+			running++;
+			launched++;
 		}
 
-	} while ((running > 0 || launched < MAX_LAUNCHED));
+		// Selects new random time to launch a new user process
+		if (launched < options.maxLaunched){
+			event.time += randomTime(MIN_FORK_TIME, MAX_FORK_TIME);
+			scheduleEvent(&events, event.time, FORK_EVENT, EMPTY);
+		}
+		break;
+
+	case IO_COMPLETION_EVENT:
+		completePaging(event.simPid, &q);
+		break;
+
+	case PRINT_EVENT:
+		logMemoryMap(pcbs, options.maxRunning, frameTable, &frameBits,
+			     getPTime(systemClock));
+		scheduleEvent(&events, event.time + MEM_INT, PRINT_EVENT,
+			      EMPTY);
+		break;
+
+	case REFERENCE_EVENT:
+		makeReferences(event.simPid);
+		break;
+
+	case PAGEOUT_EVENT:
+		finishCleaning(&disk, event.simPid, getPTime(systemClock));
+		break;
+
+	case RECLAIM_EVENT:
+		finishCleaning(&disk, event.simPid, getPTime(systemClock));
+		reclaimWriteFinished(event.simPid);
+		break;
+	}
 }
 
 // Forks & execs a user process with the assigned logical pid, returns child pid
@@ -177,8 +345,28 @@ static void launchUserProcess(){
 	int simPid;	// The logical pid of the process
 
 	// Gets the index of a pcb without a real pid assigned to it
-	if ((simPid = getFreePcbIndex(pcbs)) == -1)
+	if ((simPid = getFreePcbIndex(pcbs, options.maxRunning)) == -1)
 		perrorExit("launchUserProcess called with no free pcb");
+	statsProcessLaunch(simPid);
+
+	// Starts generating references in oss instead of forking
+	if (options.inProcess){
+		pcbs[simPid].realPid = IN_PROCESS_PID;
+		pcbs[simPid].processNum = launched;
+		initReferenceGen(&gens[simPid]);
+
+		// Gives a replayed process the pages it referenced
+		if (options.replayPath != NULL)
+			pcbs[simPid].lengthRegister = \
+				trace.lengthRegisters[launched];
+
+		processContinues(simPid);
+		resumeReferences(simPid);
+		return;
+	}
+
+	// Empties the request ring owned by the pcb
+	initRing(&rings[simPid]);
 
 	// Forks, exiting on error
 	if ((realPid = fork()) == -1)
@@ -192,232 +380,590 @@ static void launchUserProcess(){
 		sprintf(sPid, "%d", simPid);
 		
 		// Execs the child process
-		execl(USER_PROG_PATH, USER_PROG_PATH, sPid, weighted, NULL);
+		execl(USER_PROG_PATH, USER_PROG_PATH, sPid, options.weighted,
+		      options.useRings ? "1" : "0", options.batchSize, NULL);
 		perrorExit("Failed to execl");
 	}
 
-	// Assigns realPid to selected pcb in parent
+	// Assigns realPid and launch order to selected pcb in parent
 	pcbs[simPid].realPid = realPid;
+	pcbs[simPid].processNum = launched;
 
 }
 
-// Checks message queue, returning 1 and parsing message to pcb if one exists
-static int messageReceived(int * senderSimPid, int * msg){
-	char msgBuff[BUFF_SZ];	// Buffer for storing the message
-	long int msgType;	// Storage for the message type
+// Makes a batch of references for a process simulated in oss or terminates it
+static void makeReferences(int simPid){
+	ReferenceGen * gen = &gens[simPid];	// The process's generator
+	PCB * pcb = &pcbs[simPid];		// The process's pcb
+	RefMsg * msg;				// The next request to make
+	RefType type;				// Type of the next reference
+	Time now;				// Time of the next reference
+
+	// Terminates the process if it decided not to make another reference
+	if (!gen->continuing){
+		processTermination(simPid);
+		running--;
+		return;
+	}
 
-	int address;	// Referenced address
-	RefType type;	// Referenced type
+	// Makes references until the batch is full or the process terminates
+	pcb->batch.count = 0;
+	pcb->batchIndex = 0;
+	do {
+		now = getPTime(systemClock);
+		msg = &pcb->batch.msgs[pcb->batch.count++];
+
+		// Replays a recorded reference or generates a new one
+		if (options.replayPath != NULL){
+			nextTraceReference(&trace, pcb->processNum,
+					   &msg->address, &type);
+			delayNextReference(gen, now);
+		}
+		else
+			nextReference(gen, now, pcb->lengthRegister, weights,
+				      weighted, &msg->address, &type);
 
-	// Parses a message from the request message queue
-	if(getMessage(requestMqId, msgBuff, &msgType)){
+		msg->op = (type == READ_REFERENCE ? READ_MSG : WRITE_MSG);
+		msg->seq = pcb->totalReferences + pcb->batch.count;
+		msg->sent = now;
 
-		// Converts message queue values
-		*msg = atoi(msgBuff);
-		*senderSimPid = (int) msgType - 1;
+		// Increments the clock as a user process would
+		incrementPClock(systemClock, CLOCK_UPDATE);
 
-		// Returns immediately if the process terminated
-		if (*msg == TERMINATE) return 1;
+	} while (processContinues(simPid) && pcb->batch.count < batchSize);
 
-		// Decodes the address and request type
-		address = (*msg < 0 ? ~*msg : *msg);
-		type = (*msg < 0 ? WRITE_REFERENCE : READ_REFERENCE);
+	// Grants or enqueues the references
+	processBatch(simPid, &q);
+}
 
-		// Sets the last reference in the sender pcb
-		setLastReferenceInPcb(&pcbs[*senderSimPid], address, type, 
-				      getPTime(systemClock));
+// Schedules the next batch of references for a process simulated in oss
+static void resumeReferences(int simPid){
+	ReferenceGen * gen = &gens[simPid];	// The process's generator
+	Time now = getPTime(systemClock);	// The current time
+
+	// Waits until the reference time unless the process will terminate
+	if (gen->continuing && gen->referenceTime > now)
+		now = gen->referenceTime;
+
+	scheduleEvent(&events, now, REFERENCE_EVENT, simPid);
+}
+
+// Returns true if a process simulated in oss will make another reference
+static bool processContinues(int simPid){
+	ReferenceGen * gen = &gens[simPid];	// The process's generator
+
+	// Continues a replayed process until its references run out
+	if (options.replayPath != NULL)
+		return gen->continuing = \
+			traceProcessContinues(&trace, pcbs[simPid].processNum);
+
+	return referenceGenContinues(gen);
+}
+
+// Gets a batch of requests and its sender from a ring or the message queue
+static int messageReceived(int * senderSimPid, RefBatch * batch){
+	static int nextSimPid = 0;	// Ring checked first in the next call
+	long int msgType;		// Storage for the message type
+	int i;
+
+	// Checks each ring once, starting after the last ring with a request
+	if (options.useRings){
+		for (i = 0; i < options.maxRunning; i++){
+			*senderSimPid = (nextSimPid + i) % options.maxRunning;
 
+			if (ringPop(&rings[*senderSimPid], batch)){
+				nextSimPid = (*senderSimPid + 1) 
+					     % options.maxRunning;
+				return 1;
+			}
+		}
 
+		return 0;
+	}
+
+	// Converts message type to the sender's simPid
+	if (getMessage(requestMqId, batch, &msgType)){
+		*senderSimPid = (int) msgType - 1;
 		return 1;
 	}
 
 	return 0; // Returns 0 if no message was received
 }
 
+// Notifies a process that its batch of requests was granted
+static void sendReply(int simPid){
+	RefBatch reply;	// Reply to the process's last request
+
+	// Schedules more references for a process simulated in oss
+	if (options.inProcess){
+		resumeReferences(simPid);
+		return;
+	}
+
+	if (options.useRings){
+		ringReply(&rings[simPid]);
+		return;
+	}
+
+	reply.count = 1;
+	reply.msgs[0].op = REPLY_MSG;
+	reply.msgs[0].address = pcbs[simPid].lastReference.address;
+	reply.msgs[0].seq = pcbs[simPid].lastReference.seq;
+	reply.msgs[0].sent = getPTime(systemClock);
+
+	sendMessage(replyMqId, &reply, simPid + 1);
+}
+
 // Logs termination, waits for terminated process, and deallocates frames
 static void processTermination(int simPid){
 	logTermination(simPid, getPTime(systemClock), &pcbs[simPid]);
-	waitForProcess(pcbs[simPid].realPid);
+	statsProcessTermination(simPid, pcbs[simPid].processNum);
+	if (!options.inProcess)
+		waitForProcess(pcbs[simPid].realPid);
 	deallocateFrames(&pcbs[simPid]);
+	readAheadTerminated(simPid);
 	resetPcb(&pcbs[simPid]);	
 }
 
 // Deallocates all of the frames allocated to a process
 static void deallocateFrames(PCB * pcb){
+	PageTableEntry * page;
 	int i;
-	for (i = 0; i < pcb->lengthRegister; i++){
-		deallocateFrame(pcb->pageTable[i].frameNumber);
+
+	// Skips parts of the page table with no valid pages
+	for (i = nextValidPage(pcb->simPid, 0); i != EMPTY;
+	     i = nextValidPage(pcb->simPid, i + 1)){
+		page = lookupPage(pcb->simPid, i);
+
+		pageoutFreed(page->frameNumber);
+		readAheadFreed(page->frameNumber);
+		options.policy->free(page->frameNumber);
+		deallocateFrame(page->frameNumber);
+		returnFreeFrame(page->frameNumber);
 	}
 }
 
-// Checks the validity of a reference and grants it or enqueues or kills process
-static void processReference(int simPid, Queue * q){
+// Processes a process's remaining requests until one faults or all are granted
+static void processBatch(int simPid, Queue * q){
+	PCB * pcb = &pcbs[simPid];	// The pcb holding the batch
+	RefMsg * msg;			// The next request in the batch
+	RefType type;			// Referenced type
+
+	while (pcb->batchIndex < pcb->batch.count){
+		msg = &pcb->batch.msgs[pcb->batchIndex];
+
+		// Sets the request as the last reference in the pcb
+		type = (msg->op == WRITE_MSG ? WRITE_REFERENCE : READ_REFERENCE);
+		setLastReferenceInPcb(pcb, msg->address, type, msg->seq,
+				      getPTime(systemClock));
+
+		// Leaves the rest of the batch parked in the queue on a fault
+		if (!processReference(simPid, q)) return;
+
+		pcb->batchIndex++;
+	}
+
+	// Replies once every request in the batch has been granted
+	sendReply(simPid);
+}
+
+// Grants a reference, returning false if it was enqueued, or kills process
+static bool processReference(int simPid, Queue * q){
 	Reference ref;		// The memory reference to process
 	int pageNum;		// Page number of requested address
+	int frameNum;		// Frame holding the page or EMPTY
+	Time translationTime;	// Time to translate the address
 
 	// Gets the reference to process
 	ref = pcbs[simPid].lastReference;
 
 	// Gets page number
-	pageNum = ref.address / PAGE_SIZE;
+	pageNum = ref.address / options.pageSize;
 
-	// Logs request
+	// Counts and logs request
+	statsCount(STAT_MEMORY_ACCESSES);
 	logRequest(simPid, ref, getPTime(systemClock));
 
 
 	// Kills the process if the address is illegal
 	if (pageNum >= pcbs[simPid].lengthRegister){
 		perrorExit("child accessed illegal memory region");
-		return;
+		return false;
 	}
 
+	// Translates the address to find the page's frame
+	translationTime = translate(simPid, pageNum, &frameNum);
+
+	// Records the reference and tells the replacement policy about it
+	traceReference(pcbs[simPid].processNum, ref.address, ref.type,
+		       getPTime(systemClock));
+	options.policy->reference(frameNum,
+				  pageKey(pcbs[simPid].processNum, pageNum));
+	if (frameNum != EMPTY)
+		readAheadReferenced(frameNum);
+
 	// Enqueues the request if the page is invalid
-	if (!pcbs[simPid].pageTable[pageNum].valid) {
+	if (frameNum == EMPTY) {
+		statsCount(STAT_PAGE_FAULTS);
 		logPageFault(ref.address);
 		enqueue(q, &pcbs[simPid]);
-		return;
+		return false;
 	}
 
-	// Grants and logs the request otherwise
-	grantRequest(simPid);
-	logGrantedRequest(ref, pcbs[simPid].pageTable[pageNum].frameNumber,
-			  simPid, getPTime(systemClock));
+	// Grants, counts, and logs the request otherwise
+	grantRequest(simPid, translationTime);
+	statsCount(STAT_PAGE_HITS);
+	statsAccessTime(simPid, HIST_HIT_ACCESS,
+			getPTime(systemClock) - ref.startTime);
+	logGrantedRequest(ref, frameNum, simPid, getPTime(systemClock));
 
+	return true;
 }
 
-// Performs the clock replacement algorithm on queued memory references 
+// Starts paging I/O for processes at the front of the queue while the disk
+// has an idle channel
 static void checkPagingQueue(Queue * q){
-	Clock completionTime;	// Time at which I/O will complete
+	Time completionTime;	// Time at which I/O will complete
 	int frameNum;		// Number of frame to reallocate
+	long victimSlot;	// Swap slot a dirty victim is written to
+	int ahead[MAX_READ_AHEAD];	// Pages read ahead of the fault
+	int aheadFrames[MAX_READ_AHEAD];	// Frames they are read into
+	long aheadVictims[MAX_READ_AHEAD];	// Slots written before them
+	int numAhead;		// Length of ahead
+	int pageNum;		// Page the fault is on
+	PCB * pcb;		// Pcb whose fault is paged
+
+	// Writes back dirty victims of the reclaimer first, so that no fault
+	// starts while a page it could read is still waiting to be written
+	startReclaimWrites();
+
+	while (q->front != NULL && channelIdle(&disk)){
+		pcb = nextFault(&disk, q);
+		pageNum = pcb->lastReference.address / options.pageSize;
+		victimSlot = EMPTY;
+
+		// Records the time the fault waited behind others in the queue
+		statsQueueWait(getPTime(systemClock)
+			       - pcb->lastReference.startTime);
+		pcb->lastReference.wroteVictim = false;
+
+		// Takes a free frame or evicts a victim for the fault
+		if ((frameNum = takeFreeFrame(&frameBits, framesPagingIn()))
+		    == EMPTY){
+			frameNum = evictFrame(pcb, pageNum, &victimSlot);
+			pcb->lastReference.wroteVictim = victimSlot != EMPTY;
+		}
 
-	// Checks the progress of I/O if a frame was read or written
-	if (q->front != NULL && q->front->lastReference.completionTimeIsSet) {
+		// Reserves frames for the page and any read ahead of it, and
+		// schedules their read
+		reserveFrame(frameNum, pcb->simPid, pageNum, true);
+		numAhead = reserveReadAhead(pcb, ahead, aheadFrames,
+					    aheadVictims);
+		completionTime = startPaging(&disk, pcb, frameNum, victimSlot,
+					     ahead, aheadFrames, aheadVictims,
+					     numAhead, getPTime(systemClock));
+		setIoCompletionTimeInPcb(pcb, completionTime);
+		scheduleEvent(&events, completionTime, IO_COMPLETION_EVENT,
+			      pcb->simPid);
+	}
 
-		// Returns if reference end time is in the future
-		if (clockCompare(q->front->lastReference.pageCompleteTime, 
-				 getPTime(systemClock)) > 0){
-			return;
-		}
+	// Evicts frames into the free pool even while faults are queued, and
+	// writes back the dirty ones on channels no fault needs
+	while (reclaimNeeded(framesPagingIn()))
+		reclaimFrame();
+	startReclaimWrites();
 
-		// Completes memory reference if read/write has completed
-		else {
-			grantRequest(q->front->simPid);
-			q->front->lastReference.completionTimeIsSet = false;
-			logGrantedQueuedRequest(q->front->simPid, 
-						q->front->lastReference);
-			dequeue(q);
-		}
+	// Cleans dirty frames on channels no fault needs
+	while (q->front == NULL && channelIdle(&disk)
+	       && (frameNum = nextPageout(&frameBits)) != EMPTY)
+		cleanFrame(frameNum);
+}
+
+// Evicts a victim into the free pool, or queues it to be written back to
+// its swap slot first if it is dirty
+static void reclaimFrame(){
+	int frameNum = options.policy->evict(RECLAIM_KEY);
+	int simPid = frameTable[frameNum].simPid;	// Owner of the page
+	int pageNum = frameTable[frameNum].pageNum;	// Page in the frame
+	bool dirty = testFrameBit(frameBits.dirty, frameNum);
+
+	// Counts and logs the eviction
+	statsCount(STAT_EVICTIONS);
+	statsCount(STAT_BACKGROUND_RECLAIMS);
+	pageoutEvicted(frameNum, getPTime(systemClock));
+	readAheadEvicted(frameNum);
+	logReclaim(frameNum, simPid, pageNum, dirty);
+
+	// Frees a clean frame at once
+	if (!dirty){
+		deallocateFrame(frameNum);
+		returnFreeFrame(frameNum);
+		return;
 	}
 
-	if (q->count > 0){
+	// Frees a dirty frame once it has been written back
+	statsCount(STAT_DIRTY_WRITE_BACKS);
+	reclaimWriteQueued(frameNum,
+			   swapSlot(&disk, pcbs[simPid].processNum, pageNum));
+	deallocateFrame(frameNum);
+}
 
-		// Sets time swap will complete
-		copyTime(&completionTime, getPTime(systemClock));
-		incrementClock(&completionTime, IO_OP_TIME);
-		
-		// Gets available frame number or selects a victim frame
-		if ((frameNum = getIntFromBitVector()) == -1){
-			frameNum = selectVictim();
-		
-			// Logs the swap event
-			logSwap(frameNum, q->front->simPid,
-			        q->front->lastReference.address / PAGE_SIZE);
-
-			// Adds time to write frame if it is dirty
-			if (frameTable[frameNum].dirty){
-				logDirty(frameNum);
-				incrementClock(&completionTime, IO_OP_TIME);
-			}
+// Starts writing back the queued dirty victims of the reclaimer on idle
+// channels
+static void startReclaimWrites(){
+	Time completionTime;	// Time at which a write will complete
+	int frameNum;		// Frame of the victim written back
+	long slot;		// Slot it is written back to
+
+	while (channelIdle(&disk) && (frameNum = nextQueuedWrite(&slot))
+	       != EMPTY){
+		completionTime = startCleaning(&disk, frameNum, slot,
+					       getPTime(systemClock));
+		scheduleEvent(&events, completionTime, RECLAIM_EVENT,
+			      frameNum);
+	}
+}
+
+// Evicts a victim to make room for a process's page, setting victimSlot to
+// the swap slot the victim is written back to first, or EMPTY if it is
+// clean, and returns the frame freed
+static int evictFrame(PCB * pcb, int pageNum, long * victimSlot){
+	int frameNum;	// Frame of the victim
+
+	frameNum = options.policy->evict(pageKey(pcb->processNum, pageNum));
+
+	// Counts and logs the swap event
+	statsCount(STAT_EVICTIONS);
+	statsCount(STAT_DIRECT_RECLAIMS);
+	pageoutEvicted(frameNum, getPTime(systemClock));
+	readAheadEvicted(frameNum);
+	logSwap(frameNum, pcb->simPid, pageNum);
+
+	// Writes the frame back to its slot first if it is dirty
+	*victimSlot = EMPTY;
+	if (testFrameBit(frameBits.dirty, frameNum)){
+		statsCount(STAT_DIRTY_WRITE_BACKS);
+		logDirty(frameNum);
+		*victimSlot = swapSlot(&disk,
+			pcbs[frameTable[frameNum].simPid].processNum,
+			frameTable[frameNum].pageNum);
+	}
+
+	// Deallocates frame
+	deallocateFrame(frameNum);
+	return frameNum;
+}
+
+// Reserves frames for the pages read ahead of a process's fault, leaving the
+// pages given a frame at the front of pages, their frames in frames, and the
+// slots of any victims written back before them in victimSlots, and returns
+// how many there are. Pages take free frames, or evict victims until one is
+// dirty, as long as every channel could still start a fault with a frame to
+// evict
+static int reserveReadAhead(PCB * pcb, int * pages, int * frames,
+			    long * victimSlots){
+	int simPid = pcb->simPid;
+	int count;		// Pages the process's stream reads ahead
+	int reserved = 0;	// Pages given a frame
+	int frameNum;		// Frame given to a page
+	long victimSlot = EMPTY;// Slot of the last victim written back
+	int i;
+
+	count = readAheadPages(simPid,
+			       pcb->lastReference.address / options.pageSize,
+			       pcb->lengthRegister, pages);
+
+	for (i = 0; i < count && victimSlot == EMPTY; i++){
+		if (lookupPage(simPid, pages[i])->valid) continue;
 
-			// Sets completion time and deallocates frame
-			setIoCompletionTimeInPcb(q->front, completionTime);
-			deallocateFrame(frameNum);
+		if (readAheadInFlight() + disk.numChannels >= config->numFrames)
+			break;
+
+		// Counts the fault's own frame as being paged in
+		if ((frameNum = takeFreeFrame(&frameBits, framesPagingIn() + 1))
+		    == EMPTY){
+			if (!victimAvailable(framesPagingIn() + 1)) break;
+			frameNum = evictFrame(pcb, pages[i], &victimSlot);
 		}
-	
-		// Allocates the frame to the front of the queue
-		allocateFrame(frameNum, q->front);
+
+		reserveFrame(frameNum, simPid, pages[i], false);
+		readAheadIssued(simPid, pages[i], frameNum);
+		frames[reserved] = frameNum;
+		victimSlots[reserved] = victimSlot;
+		pages[reserved++] = pages[i];
 	}
 
+	return reserved;
 }
 
-// Allocates a frame to a process
-static void allocateFrame(int frameNum, PCB * pcb){
-	int pageNum = pcb->lastReference.address / PAGE_SIZE;
+// Returns the number of frames being paged in, which cannot be evicted
+static int framesPagingIn(){
+	return disk.inFlight + readAheadInFlight();
+}
 
-	// Updates bit vector
-	reserveInBitVector(frameNum);
+// Starts writing a dirty frame back to its swap slot, leaving its page
+// resident and clean
+static void cleanFrame(int frameNum){
+	int simPid = frameTable[frameNum].simPid;	// Owner of the page
+	int pageNum = frameTable[frameNum].pageNum;	// Page in the frame
+	Time now = getPTime(systemClock);
+	Time completionTime;	// Time at which the write will complete
+
+	markClean(&frameBits, frameNum);
+	lookupPage(simPid, pageNum)->dirty = 0;
+
+	completionTime = startCleaning(&disk, frameNum,
+		swapSlot(&disk, pcbs[simPid].processNum, pageNum), now);
+	pageoutStarted(frameNum, now, completionTime);
+	scheduleEvent(&events, completionTime, PAGEOUT_EVENT, frameNum);
+}
+
+// Grants the reference of a process once its page has been read, handing
+// the frame to the replacement policy
+static void completePaging(int simPid, Queue * q){
+	PCB * pcb;	// Pcb whose reference was completed
+	int pageNum;	// Page number of the completed reference
+	int frameNum;	// Frame the page was read into
+	const int * aheadFrames;	// Frames of pages read ahead
+	int numAhead;	// Length of aheadFrames
+	int i;
+
+	pcb = finishPaging(&disk, simPid, getPTime(systemClock), &frameNum);
+	pageNum = pcb->lastReference.address / options.pageSize;
+	clearFrameBit(frameBits.busy, frameNum);
+	options.policy->allocate(frameNum, pageKey(pcb->processNum, pageNum));
+
+	// Hands the frames read ahead in the same transfer to the policy too
+	numAhead = readAheadArrived(simPid, &aheadFrames);
+	for (i = 0; i < numAhead; i++){
+		clearFrameBit(frameBits.busy, aheadFrames[i]);
+		options.policy->allocate(aheadFrames[i],
+			pageKey(pcb->processNum,
+				frameTable[aheadFrames[i]].pageNum));
+	}
+
+	// Completes memory reference, walking the page table again to retry it
+	tlbInsert(simPid, pageNum, frameNum);
+	grantRequest(simPid, missTime(getPageTableDepth()));
+	pcb->lastReference.completionTimeIsSet = false;
+	statsAccessTime(simPid, pcb->lastReference.wroteVictim ?
+				HIST_DIRTY_FAULT_ACCESS : HIST_FAULT_ACCESS,
+			pcb->lastReference.endTime
+			- pcb->lastReference.startTime);
+	logGrantedQueuedRequest(simPid, pcb->lastReference);
+
+	// Resumes the rest of the process's batch
+	pcb->batchIndex++;
+	processBatch(pcb->simPid, q);
+}
+
+// Allocates a frame to a process's page, marking it busy until the page is
+// read in so that it cannot be chosen as a victim, and referenced unless the
+// page is only read ahead
+static void reserveFrame(int frameNum, int simPid, int pageNum,
+			 bool referenced){
+
+	// Updates bitmaps
+	setFrameBit(frameBits.allocated, frameNum);
+	if (referenced){
+		setFrameBit(frameBits.reference, frameNum);
+		setFrameBit(frameBits.active, frameNum);
+	}
+	setFrameBit(frameBits.busy, frameNum);
+	markClean(&frameBits, frameNum);
 
 	// Updates page table
-	pcb->pageTable[pageNum].frameNumber = frameNum;
-	pcb->pageTable[pageNum].valid = 1;
-	pcb->pageTable[pageNum].dirty = 0;
+	mapPage(simPid, pageNum, frameNum);
 
 	// Updates frame table
-	frameTable[frameNum].simPid = pcb->simPid;
+	frameTable[frameNum].simPid = simPid;
 	frameTable[frameNum].pageNum = pageNum;
-	frameTable[frameNum].reference = 1;
-	frameTable[frameNum].dirty = 0;
 }
 
 // Deallocates a frame from a process
 static void deallocateFrame(int frameNum){
 
-	// updates bit vector
-	freeInBitVector(frameNum);
+	// Updates bitmaps
+	clearFrameBit(frameBits.allocated, frameNum);
+	markClean(&frameBits, frameNum);
 
 	// Gets process and page indices from frame descriptor
 	int simPid = frameTable[frameNum].simPid;
 	int pageNum = frameTable[frameNum].pageNum;
 
-	// Deallocates frame in page table
-	if (simPid != (char) EMPTY)
-		pcbs[simPid].pageTable[pageNum].valid = 0;
+	// Deallocates frame in page table and invalidates any cached translation
+	if (simPid != EMPTY){
+		unmapPage(simPid, pageNum);
+		tlbShootdown(simPid, pageNum);
+	}
 
 	// Deallocates frame in frame table
-	frameTable[frameNum].simPid = (char) EMPTY;
-
-}
-
-// Returns the frame number of a victim frame using clock replacement
-static int selectVictim(){
-	static int headIndex = 0;
+	frameTable[frameNum].simPid = EMPTY;
 
-	while(frameTable[headIndex].reference){
-		frameTable[headIndex].reference = 0;
-		headIndex = (headIndex + 1) % NUM_FRAMES;
-	}
-
-	return headIndex;
 }
 
 // Increments clock and sets reference and dirty bit if the operation was a write 
-static void grantRequest(int simPid){
+static void grantRequest(int simPid, Time translationTime){
 	int logicalAddress;	// The requested logical address
 	int pageNum;		// Page number of requested address
 	PageTableEntry * page;	// Page corresponding to the address
 	
 	// Gets requested logical address and computes page number and offset
 	logicalAddress = pcbs[simPid].lastReference.address;
-	pageNum = logicalAddress / PAGE_SIZE;
-	page = &pcbs[simPid].pageTable[pageNum];
+	pageNum = logicalAddress / options.pageSize;
+	page = lookupPage(simPid, pageNum);
 
 	// Sets dirty bits if operation was write operation
 	if (pcbs[simPid].lastReference.type == WRITE_REFERENCE){
-		frameTable[page->frameNumber].dirty = 1;
+		pageoutDirtied(page->frameNumber);
+		markDirty(&frameBits, page->frameNumber);
 		page->dirty = 1;
 	}
 
 	// Sets reference
-	frameTable[page->frameNumber].reference = 1;
+	setFrameBit(frameBits.reference, page->frameNumber);
+	setFrameBit(frameBits.active, page->frameNumber);
 
-	// Increments clock
-	incrementPClock(systemClock, MEM_ACCESS_TIME);
+	// Increments clock by the time to translate and access the address
+	incrementPClock(systemClock, translationTime + options.memoryTime);
+	statsAdd(STAT_TRANSLATION_TIME, translationTime);
 
 	// Resets reference in pcb
 	completeReferenceInPcb(&pcbs[simPid], getPTime(systemClock));
+}
+
+// Returns the time to find a page's frame, which is set to EMPTY if the page
+// is invalid, looking in the tlb before walking the page table
+static Time translate(int simPid, int pageNum, int * frameNum){
+	PageTableEntry * page;	// Page table entry of the page
+	int levelsRead;		// Page table levels walked
+
+	// Returns the frame cached in the tlb if there is one
+	if (options.tlbEntries > 0){
+		tlbSwitchTo(simPid);
+		if ((*frameNum = tlbLookup(simPid, pageNum)) != EMPTY)
+			return TLB_ACCESS_TIME;
+	}
 
-	// Sends reply message
-	sendMessage(replyMqId, "\0", simPid + 1);
+	// Walks the page table, caching the frame of a valid page
+	page = walkPageTable(simPid, pageNum, &levelsRead);
+
+	*frameNum = page->valid ? page->frameNumber : EMPTY;
+	if (page->valid)
+		tlbInsert(simPid, pageNum, page->frameNumber);
+
+	return missTime(levelsRead);
+}
+
+// Returns the time to miss in the tlb, if there is one, and then read an
+// entry from memory at each level of a page table walk
+static Time missTime(int levelsRead){
+	Time time = levelsRead * options.memoryTime;
+
+	if (options.tlbEntries > 0)
+		time += TLB_ACCESS_TIME;
+
+	return time;
 }
 
 // Initializes an array of weights for address selection in child processes
@@ -425,12 +971,12 @@ static void initWeights(double * weights){
 	int i;
 
 	// Initializes each element n to 1/n
-	for (i = 0; i < MAX_ALLOC_PAGES; i++){
+	for (i = 0; i < config->maxPages; i++){
 		weights[i] = 1.0 / (double) (i + 1);
 	}
 
 	// Adds the sum of the previous elements to each element
-	for (i = 1; i < MAX_ALLOC_PAGES; i++){
+	for (i = 1; i < config->maxPages; i++){
 		weights[i] += weights[i - 1];
 	}
 
@@ -449,16 +995,23 @@ static void waitForProcess(pid_t realPid){
 
 // Determines the processes response to ctrl + c or alarm
 static void assignSignalHandlers(){
-	struct sigaction sigact;
+	struct sigaction sigact;	// Response to ctrl + c & alarm
+	struct sigaction wakeAct;	// Response to a child exiting
 
 	// Initializes sigaction values
 	sigact.sa_handler = cleanUpAndExit;
 	sigact.sa_flags = 0;
 
-	// Assigns signals to sigact
+	// Interrupts sleep on the doorbell when a child exits
+	wakeAct.sa_handler = wakeOnChildExit;
+	wakeAct.sa_flags = 0;
+
+	// Assigns signals to sigact and wakeAct
 	if ((sigemptyset(&sigact.sa_mask) == -1)
+	    ||(sigemptyset(&wakeAct.sa_mask) == -1)
 	    ||(sigaction(SIGALRM, &sigact, NULL) == -1)
-	    ||(sigaction(SIGINT, &sigact, NULL)  == -1)){
+	    ||(sigaction(SIGINT, &sigact, NULL)  == -1)
+	    ||(sigaction(SIGCHLD, &wakeAct, NULL) == -1)){
 
 		// Prints error message and exits on failure
 		char buff[BUFF_SZ];
@@ -469,6 +1022,10 @@ static void assignSignalHandlers(){
 	}
 }
 
+// Signal handler - returns so that waiting on the doorbell is interrupted
+static void wakeOnChildExit(int param){
+}
+
 // Signal handler - closes files, removes shm, terminates children, and exits
 static void cleanUpAndExit(int param){
 
@@ -498,20 +1055,13 @@ static void cleanUp(){
 	// Kills all other processes in the same process group
 	kill(0, SIGQUIT);
 
-	// Destroys semaphore protecting system clock
-	while (pthread_mutex_destroy(&systemClock->sem) != 0 && errno == EBUSY);
-	if (errno == EINVAL){
-		char buff[BUFF_SZ];
-		sprintf(buff, "%s: Error: ", exeName);
-		perror("Attempted to destroy invalid semaphore");
-	}
-
-	// Removes message queues
-	removeMessageQueue(requestMqId);
-	removeMessageQueue(replyMqId);
+	// Removes message queues if they were created
+	if (requestMqId != EMPTY) removeMessageQueue(requestMqId);
+	if (replyMqId != EMPTY) removeMessageQueue(replyMqId);
 
-	// Closes log file
+	// Closes log and trace files
 	closeLogFile();
+	closeTraceFile();
 
 	// Detatches from and removes shared memory
 	detach(shm);
@@ -0,0 +1,210 @@
+// osslog.c was created by Mark Renard on 5/11/2020.
+//
+// This program renders the binary log written by oss as the text log of
+// assignment 6. It reads the records of LOG_FILE_NAME, or of the file named
+// by its first argument, and prints the line each one stands for to stdout,
+// or to the file named by its second argument.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "clock.h"
+#include "constants.h"
+#include "logEvent.h"
+#include "perrorExit.h"
+
+#define READ_EVENTS 4096	// Records read from the log at once
+
+// Prototypes
+static bool readEvent(FILE * in, LogEvent * event);
+static void renderEvent(FILE * in, FILE * out, const LogEvent * event);
+static void renderText(FILE * in, FILE * out, int length);
+
+// Static global variables
+static LogEvent events[READ_EVENTS];	// Records read but not rendered
+static size_t numEvents = 0;		// Records in events
+static size_t nextEvent = 0;		// Index of the next record to render
+
+int main(int argc, char * argv[]){
+	const char * inPath = LOG_FILE_NAME;	// The binary log
+	char header[LOG_HEADER_SIZE];		// First bytes of the log
+	LogEvent event;				// The record being rendered
+	FILE * in;
+	FILE * out = stdout;
+
+	exeName = argv[0];	// Assigns exeName for perrorExit
+	signalGroup = false;	// Exits alone on errors, outside oss
+
+	if (argc > 3){
+		fprintf(stderr, "\nusage: \n\t%s [log [text]]\n\nRenders the "
+			"binary log oss writes (default %s) as text to\nthe "
+			"file text or stdout.\n", exeName, LOG_FILE_NAME);
+		exit(1);
+	}
+	if (argc > 1) inPath = argv[1];
+
+	if ((in = fopen(inPath, "r")) == NULL)
+		perrorExit("Failed to open log");
+
+	if (fread(header, 1, LOG_HEADER_SIZE, in) != LOG_HEADER_SIZE
+	    || memcmp(header, LOG_MAGIC, LOG_HEADER_SIZE) != 0)
+		perrorExit("Log has an unknown format");
+
+	if (argc > 2 && (out = fopen(argv[2], "w")) == NULL)
+		perrorExit("Failed to open text log");
+
+	while (readEvent(in, &event))
+		renderEvent(in, out, &event);
+
+	if (out != stdout && fclose(out) != 0)
+		perrorExit("Failed to close text log");
+	fclose(in);
+
+	return 0;
+}
+
+// Gets the next record of the log, returning false at the end of it
+static bool readEvent(FILE * in, LogEvent * event){
+	if (nextEvent == numEvents){
+		numEvents = fread(events, sizeof(LogEvent), READ_EVENTS, in);
+		nextEvent = 0;
+		if (numEvents == 0) return false;
+	}
+
+	*event = events[nextEvent++];
+	return true;
+}
+
+// Prints the line a record stands for
+static void renderEvent(FILE * in, FILE * out, const LogEvent * event){
+	const int32_t * args = event->args;
+	int j;
+
+	switch (event->type){
+	case LOG_TERMINATION:
+		fprintf(out, "Master: P%d has terminated at time %03d : %09d\n",
+			args[0], timeSeconds(event->time),
+			timeNanoseconds(event->time));
+		fprintf(out, "\t\t Effective memory access time: %03d : %09d\n",
+			timeSeconds(event->value),
+			timeNanoseconds(event->value));
+		break;
+
+	case LOG_READ_REQUEST:
+		fprintf(out, "Master: P%d requesting read of address %d at "
+			"time %03d : %09d\n", args[0], args[1],
+			timeSeconds(event->time), timeNanoseconds(event->time));
+		break;
+
+	case LOG_READ_GRANTED:
+		fprintf(out, "Master: Address %d in frame %d, giving data to "
+			"P%d at time %03d : %09d\n", args[0], args[1], args[2],
+			timeSeconds(event->time), timeNanoseconds(event->time));
+		break;
+
+	case LOG_WRITE_REQUEST:
+		fprintf(out, "Master: P%d requesting write of address %d at "
+			"time %03d : %09d\n", args[0], args[1],
+			timeSeconds(event->time), timeNanoseconds(event->time));
+		break;
+
+	case LOG_WRITE_GRANTED:
+		fprintf(out, "Master: Address %d in frame %d, writing data "
+			"from P%d to frame at time %03d : %09d\n", args[0],
+			args[1], args[2], timeSeconds(event->time),
+			timeNanoseconds(event->time));
+		break;
+
+	case LOG_PAGE_FAULT:
+		fprintf(out, "Master: Address %d is not in a frame, "
+			"pagefault\n", args[0]);
+		break;
+
+	case LOG_SWAP:
+		fprintf(out, "Master: Clearing frame %d and swapping in P%d "
+			"page %d\n", args[0], args[1], args[2]);
+		break;
+
+	case LOG_DIRTY:
+		fprintf(out, "Master: Dirty bit of frame %d was set, adding "
+			"additional time to the clock\n", args[0]);
+		break;
+
+	case LOG_RECLAIM:
+		fprintf(out, "Master: Reclaiming frame %d from P%d page %d "
+			"into the free pool%s\n", args[0], args[1], args[2],
+			event->value ? ", writing it back first" : "");
+		break;
+
+	case LOG_READ_INDICATION:
+		fprintf(out, "Master: Indicating to P%d that data can be read "
+			"from address %d\n", args[0], args[1]);
+		break;
+
+	case LOG_WRITE_INDICATION:
+		fprintf(out, "Master: Indicating to P%d that write has "
+			"happened to address %d\n", args[0], args[1]);
+		break;
+
+	case LOG_MEMORY_MAP:
+		fprintf(out, "\nCurrent memory layout at time %03d : %09d "
+			"is:\n", timeSeconds(event->time),
+			timeNanoseconds(event->time));
+		break;
+
+	case LOG_PAGE_HEADER:
+		fprintf(out, "\n     ");
+		for (j = 0; j < args[0]; j++)
+			fprintf(out, "%2d ", j);
+		fprintf(out, "\n");
+		break;
+
+	case LOG_PAGE_ROW:
+		fprintf(out, "P%2d: ", args[0]);
+		for (j = 0; j < args[1]; j++)
+			fprintf(out, event->value >> j & 1 ? " + " : " . ");
+		fprintf(out, "\n");
+		break;
+
+	case LOG_PAGE_COUNT:
+		fprintf(out, "P%2d: %d of %d pages resident\n", args[0],
+			args[1], args[2]);
+		break;
+
+	case LOG_FRAME_HEADER:
+		fprintf(out, "\t\tProcess\tRefByte\tDirtyBit\n");
+		break;
+
+	case LOG_FRAME:
+		fprintf(out, "Frame %03d:\t%d\t%d\t%d\n", args[0], args[1],
+			args[2], (int) event->value);
+		break;
+
+	case LOG_BLANK_LINE:
+		fprintf(out, "\n");
+		break;
+
+	case LOG_TEXT:
+		renderText(in, out, args[0]);
+		break;
+
+	default:
+		perrorExit("Log contains a record of an unknown type");
+	}
+}
+
+// Prints text stored in the records following a LOG_TEXT record
+static void renderText(FILE * in, FILE * out, int length){
+	LogEvent chunk;	// Record holding part of the text
+	int i;
+
+	for (i = 0; i < length; i += sizeof(LogEvent)){
+		if (!readEvent(in, &chunk))
+			perrorExit("Log ends in the middle of text");
+
+		fwrite(&chunk, 1, length - i < (int) sizeof(LogEvent) ?
+				  length - i : (int) sizeof(LogEvent), out);
+	}
+}
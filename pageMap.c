@@ -0,0 +1,89 @@
+// pageMap.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains functions for a hash map using linear probing. Removed
+// keys are filled by shifting later keys in the same run backward, so lookups
+// never need to skip deleted slots.
+
+#include <stdlib.h>
+
+#include "constants.h"
+#include "pageMap.h"
+#include "replacementPolicy.h"
+
+// Prototypes
+static unsigned long homeSlot(const PageMap * map, PageKey key);
+static unsigned long slotOf(const PageMap * map, PageKey key);
+
+// Allocates an empty map with at least twice as many slots as entries
+void initPageMap(PageMap * map, int maxEntries){
+	unsigned long size = 1;
+	unsigned long i;
+
+	while (size < 2 * (unsigned long) maxEntries) size *= 2;
+
+	map->keys = policyAlloc(sizeof(PageKey) * size);
+	map->values = policyAlloc(sizeof(int) * size);
+	map->mask = size - 1;
+
+	for (i = 0; i < size; i++)
+		map->keys[i] = EMPTY;
+}
+
+// Frees the slots of a map
+void freePageMap(PageMap * map){
+	free(map->keys);
+	free(map->values);
+}
+
+// Returns the value of the key or EMPTY if it is not in the map
+int pageMapGet(const PageMap * map, PageKey key){
+	unsigned long slot = slotOf(map, key);
+
+	return map->keys[slot] == key ? map->values[slot] : EMPTY;
+}
+
+// Sets the value of the key, adding it if it is not in the map
+void pageMapPut(PageMap * map, PageKey key, int value){
+	unsigned long slot = slotOf(map, key);
+
+	map->keys[slot] = key;
+	map->values[slot] = value;
+}
+
+// Removes the key from the map if it is present
+void pageMapRemove(PageMap * map, PageKey key){
+	unsigned long slot = slotOf(map, key);	// Slot being emptied
+	unsigned long next;			// Slot after it in the run
+	unsigned long home;			// Where next's key hashes
+
+	if (map->keys[slot] != key) return;
+
+	// Moves back each later key in the run that may not skip the hole
+	for (next = (slot + 1) & map->mask; map->keys[next] != EMPTY;
+	     next = (next + 1) & map->mask){
+		home = homeSlot(map, map->keys[next]);
+
+		if (((next - home) & map->mask) >= ((next - slot) & map->mask)){
+			map->keys[slot] = map->keys[next];
+			map->values[slot] = map->values[next];
+			slot = next;
+		}
+	}
+
+	map->keys[slot] = EMPTY;
+}
+
+// Returns the first slot probed for the key
+static unsigned long homeSlot(const PageMap * map, PageKey key){
+	return ((unsigned long) key * 0x9E3779B97F4A7C15UL >> 20) & map->mask;
+}
+
+// Returns the slot holding the key or the empty slot where it would go
+static unsigned long slotOf(const PageMap * map, PageKey key){
+	unsigned long slot = homeSlot(map, key);
+
+	while (map->keys[slot] != EMPTY && map->keys[slot] != key)
+		slot = (slot + 1) & map->mask;
+
+	return slot;
+}
@@ -0,0 +1,23 @@
+// pageMap.h was created by Mark Renard on 5/10/2020.
+//
+// This file defines a fixed-capacity hash map from page keys to integers,
+// used by replacement policies to find the entries of pages they remember.
+
+#ifndef PAGEMAP_H
+#define PAGEMAP_H
+
+#include "replacementPolicy.h"
+
+typedef struct pageMap {
+	PageKey * keys;		// Key in each slot or EMPTY
+	int * values;		// Value of the key in each slot
+	unsigned long mask;	// Number of slots minus one
+} PageMap;
+
+void initPageMap(PageMap * map, int maxEntries);
+void freePageMap(PageMap * map);
+int pageMapGet(const PageMap * map, PageKey key);
+void pageMapPut(PageMap * map, PageKey key, int value);
+void pageMapRemove(PageMap * map, PageKey key);
+
+#endif
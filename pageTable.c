@@ -0,0 +1,369 @@
+// pageTable.c was created by Mark Renard on 5/11/2020.
+//
+// This file contains functions that walk, fill, and prune the radix trees of
+// page tables in shared memory. A tree has just enough levels for its root to
+// have at most PAGE_TABLE_FANOUT entries, and each level below the root uses
+// the next PAGE_TABLE_BITS bits of the page number. Entries of interior nodes
+// are node indices, and entries of leaves are page table entries. Each node
+// counts its non-empty entries, and a free node's count links the free list.
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "constants.h"
+#include "pageTable.h"
+#include "perrorExit.h"
+
+// Prototypes
+static void computeShape(int pages, int * treeDepth, int * treeRootSize);
+static int computeNumNodes(int pcbs, int numFrames, int pages);
+static int * rootSlot(int simPid, int pageNum);
+static int slotIndex(int level, int pageNum);
+static int * children(int node);
+static PageTableEntry * leafEntry(int node, int pageNum);
+static PageTableEntry * walk(int simPid, int pageNum, int * levelsRead);
+static void countWalk(int levels, int endLevel);
+static int allocNode(bool leaf);
+static int findValid(int node, int level, int base, int fromPage);
+static void freeNode(int node);
+
+// Static global variables
+static PageTableArena * arena;	// Pool state in shared memory
+static PageTableEntry * nodes;	// Entries of every node in the pool
+static int * roots;		// Root of each process's tree
+static int * counts;		// Non-empty entries of each node or next free
+static int * resident;		// Valid pages in each process's tree
+
+static int numPcbs;		// Number of processes with a tree
+static int maxPages;		// Max number of pages allocated to a process
+static int depth;		// Levels in each tree, counting the root
+static int rootSize;		// Entries in the root of each tree
+static int numNodes;		// Nodes in the pool
+
+static PageTableEntry unmapped = {EMPTY, 0, 0};	// Entry of missing pages
+
+static long levelReads[MAX_PAGE_TABLE_DEPTH];	// Entries read at each level
+static long levelMisses[MAX_PAGE_TABLE_DEPTH];	// Walks ended at each level
+
+// Returns the bytes of shared memory needed for the page tables
+size_t pageTableArenaSize(int pcbs, int numFrames, int pages){
+	int treeDepth, treeRootSize;
+	int poolNodes = computeNumNodes(pcbs, numFrames, pages);
+
+	computeShape(pages, &treeDepth, &treeRootSize);
+
+	return sizeof(PageTableArena)
+	       + sizeof(PageTableEntry) * PAGE_TABLE_FANOUT * poolNodes
+	       + sizeof(int) * ((size_t) pcbs * (treeRootSize + 1) + poolNodes);
+}
+
+// Sets the location and shape of the page tables in shared memory
+void setPageTables(PageTableArena * pageTableArena, int pcbs, int numFrames,
+		   int pages){
+	numPcbs = pcbs;
+	maxPages = pages;
+	computeShape(maxPages, &depth, &rootSize);
+	numNodes = computeNumNodes(numPcbs, numFrames, maxPages);
+
+	arena = pageTableArena;
+	nodes = (PageTableEntry *)(arena + 1);
+	roots = (int *)(nodes + (size_t) PAGE_TABLE_FANOUT * numNodes);
+	counts = roots + (size_t) numPcbs * rootSize;
+	resident = counts + numNodes;
+}
+
+// Empties every tree and puts every node on the free list
+void initPageTables(){
+	long i;
+
+	for (i = 0; i < (long) numPcbs * rootSize; i++)
+		roots[i] = EMPTY;
+
+	for (i = 0; i < numNodes; i++)
+		counts[i] = i + 1 < numNodes ? i + 1 : EMPTY;
+
+	for (i = 0; i < numPcbs; i++)
+		resident[i] = 0;
+
+	arena->freeNode = numNodes > 0 ? 0 : EMPTY;
+	arena->nodesInUse = 0;
+	arena->peakNodes = 0;
+}
+
+// Returns the max number of pages allocated to a process
+int getMaxPages(){
+	return maxPages;
+}
+
+// Returns the number of levels in each tree, counting the root
+int getPageTableDepth(){
+	return depth;
+}
+
+// Returns the entry for a page, or an invalid entry if no leaf holds it
+PageTableEntry * lookupPage(int simPid, int pageNum){
+	return walk(simPid, pageNum, NULL);
+}
+
+// Returns the entry for a page like lookupPage, counting the entries read
+// at each level and setting levelsRead to the number read by this walk
+PageTableEntry * walkPageTable(int simPid, int pageNum, int * levelsRead){
+	return walk(simPid, pageNum, levelsRead);
+}
+
+// Makes a page valid in the frame, adding any nodes missing on its path
+void mapPage(int simPid, int pageNum, int frameNum){
+	int * slot = rootSlot(simPid, pageNum);	// Entry of the next node
+	int parent = EMPTY;			// Node holding slot
+	PageTableEntry * page;			// Entry of the page
+	int level;
+
+	// Follows the path from the root, filling empty slots with new nodes
+	for (level = 1; level < depth; level++){
+		if (*slot == EMPTY){
+			*slot = allocNode(level == depth - 1);
+			if (parent != EMPTY) counts[parent]++;
+		}
+		parent = *slot;
+
+		if (level < depth - 1)
+			slot = &children(parent)[slotIndex(level, pageNum)];
+	}
+
+	// Fills the entry in the leaf
+	page = leafEntry(parent, pageNum);
+	if (!page->valid){
+		counts[parent]++;
+		resident[simPid]++;
+	}
+	page->frameNumber = frameNum;
+	page->valid = 1;
+	page->dirty = 0;
+}
+
+// Makes a page invalid, freeing nodes with no valid pages left below them
+void unmapPage(int simPid, int pageNum){
+	int * slots[MAX_PAGE_TABLE_DEPTH];	// Entry of the node at each level
+	PageTableEntry * page;			// Entry of the page
+	int level;
+
+	// Finds the path from the root to the leaf, returning if it is cut
+	slots[1] = rootSlot(simPid, pageNum);
+	for (level = 1; level < depth - 1; level++){
+		if (*slots[level] == EMPTY) return;
+		slots[level + 1] = &children(*slots[level])
+				   [slotIndex(level, pageNum)];
+	}
+	if (*slots[depth - 1] == EMPTY) return;
+
+	// Clears the entry in the leaf
+	page = leafEntry(*slots[depth - 1], pageNum);
+	if (!page->valid) return;
+	page->valid = 0;
+	page->dirty = 0;
+	resident[simPid]--;
+
+	// Frees emptied nodes from the leaf up
+	for (level = depth - 1; level >= 1 && --counts[*slots[level]] == 0;
+	     level--){
+		freeNode(*slots[level]);
+		*slots[level] = EMPTY;
+	}
+}
+
+// Returns the first valid page of a process at or after a page, or EMPTY
+int nextValidPage(int simPid, int fromPage){
+	int span = 1 << (PAGE_TABLE_BITS * (depth - 1));  // Pages per entry
+	int found;
+	int i;
+
+	for (i = fromPage / span; i < rootSize; i++){
+		found = findValid(roots[(long) simPid * rootSize + i], 1,
+				  i * span, fromPage);
+		if (found != EMPTY) return found;
+	}
+
+	return EMPTY;
+}
+
+// Returns the number of valid pages in a process's tree
+int countResidentPages(int simPid){
+	return resident[simPid];
+}
+
+// Returns the number of entries walkPageTable read at a level
+long getLevelReads(int level){
+	return levelReads[level];
+}
+
+// Returns the number of walks that found no valid page at a level
+long getLevelMisses(int level){
+	return levelMisses[level];
+}
+
+// Returns the bytes used by the roots and nodes in use or at their peak
+size_t getPageTableBytes(bool peak){
+	return sizeof(int) * (size_t) numPcbs * (rootSize + 1)
+	       + (sizeof(PageTableEntry) * PAGE_TABLE_FANOUT + sizeof(int))
+		 * (size_t) (peak ? arena->peakNodes : arena->nodesInUse);
+}
+
+// Returns the bytes a flat table of every allocatable page would use
+size_t getFlatPageTableBytes(){
+	return sizeof(PageTableEntry) * (size_t) numPcbs * maxPages;
+}
+
+// Finds the fewest levels, counting the root, whose root fits in one node
+static void computeShape(int pages, int * treeDepth, int * treeRootSize){
+	long span = PAGE_TABLE_FANOUT;	// Pages below each entry of the root
+
+	*treeDepth = 2;
+	while ((pages + span - 1) / span > PAGE_TABLE_FANOUT){
+		span *= PAGE_TABLE_FANOUT;
+		(*treeDepth)++;
+	}
+	*treeRootSize = (pages + span - 1) / span;
+}
+
+// Returns the most nodes below the roots that can have valid pages at once
+static int computeNumNodes(int pcbs, int numFrames, int pages){
+	int treeDepth, treeRootSize;
+	long span = PAGE_TABLE_FANOUT;	// Pages below a node at the level
+	long total = 0;			// Nodes needed at every level
+	long needed;			// Nodes needed at the level
+	int level;
+
+	computeShape(pages, &treeDepth, &treeRootSize);
+
+	// Each node in use has a page in a frame below it
+	for (level = treeDepth - 1; level >= 1; level--){
+		needed = (long) pcbs * ((pages + span - 1) / span);
+		total += needed < numFrames ? needed : numFrames;
+		span *= PAGE_TABLE_FANOUT;
+	}
+
+	return total;
+}
+
+// Returns the entry in the root of a process's tree on a page's path
+static int * rootSlot(int simPid, int pageNum){
+	return &roots[(long) simPid * rootSize
+		      + (pageNum >> (PAGE_TABLE_BITS * (depth - 1)))];
+}
+
+// Returns the index of a page's entry in the node at a level
+static int slotIndex(int level, int pageNum){
+	return (pageNum >> (PAGE_TABLE_BITS * (depth - 1 - level)))
+	       & (PAGE_TABLE_FANOUT - 1);
+}
+
+// Returns the entries of an interior node
+static int * children(int node){
+	return (int *) &nodes[(long) node * PAGE_TABLE_FANOUT];
+}
+
+// Returns a page's entry in a leaf
+static PageTableEntry * leafEntry(int node, int pageNum){
+	return &nodes[(long) node * PAGE_TABLE_FANOUT
+		      + slotIndex(depth - 1, pageNum)];
+}
+
+// Follows a page's path from the root, counting entries read if levelsRead
+// is not NULL
+static PageTableEntry * walk(int simPid, int pageNum, int * levelsRead){
+	int node = *rootSlot(simPid, pageNum);
+	PageTableEntry * page;
+	int level;
+
+	// Reads interior nodes until the path ends or reaches a leaf
+	for (level = 1; node != EMPTY && level < depth - 1; level++)
+		node = children(node)[slotIndex(level, pageNum)];
+
+	// Returns an invalid entry if a node on the path is missing
+	if (node == EMPTY){
+		if (levelsRead != NULL){
+			*levelsRead = level;
+			countWalk(level, level - 1);
+		}
+		return &unmapped;
+	}
+
+	page = leafEntry(node, pageNum);
+	if (levelsRead != NULL){
+		*levelsRead = level + 1;
+		countWalk(level + 1, page->valid ? EMPTY : level);
+	}
+
+	return page;
+}
+
+// Counts the entries read by a walk of levels levels that ended at a level
+// without a valid page, or EMPTY if it found one
+static void countWalk(int levels, int endLevel){
+	int level;
+
+	for (level = 0; level < levels; level++)
+		levelReads[level]++;
+
+	if (endLevel != EMPTY)
+		levelMisses[endLevel]++;
+}
+
+// Takes a node from the pool with every entry empty
+static int allocNode(bool leaf){
+	int node = arena->freeNode;
+	int i;
+
+	if (node == EMPTY)
+		perrorExit("Page table pool is empty");
+
+	arena->freeNode = counts[node];
+	counts[node] = 0;
+	if (++arena->nodesInUse > arena->peakNodes)
+		arena->peakNodes = arena->nodesInUse;
+
+	for (i = 0; i < PAGE_TABLE_FANOUT; i++){
+		if (leaf)
+			nodes[(long) node * PAGE_TABLE_FANOUT + i] = unmapped;
+		else
+			children(node)[i] = EMPTY;
+	}
+
+	return node;
+}
+
+// Returns the first valid page at or after fromPage below a node whose first
+// page is base, or EMPTY if there is none
+static int findValid(int node, int level, int base, int fromPage){
+	int span = 1 << (PAGE_TABLE_BITS * (depth - 1 - level));
+	int found;
+	int i;
+
+	if (node == EMPTY) return EMPTY;
+
+	i = fromPage > base ? (fromPage - base) / span : 0;
+	for ( ; i < PAGE_TABLE_FANOUT; i++){
+
+		// Checks the entry of each page in a leaf
+		if (level == depth - 1){
+			if (nodes[(long) node * PAGE_TABLE_FANOUT + i].valid)
+				return base + i;
+		}
+
+		// Searches the child of each entry in an interior node
+		else {
+			found = findValid(children(node)[i], level + 1,
+					  base + i * span, fromPage);
+			if (found != EMPTY) return found;
+		}
+	}
+
+	return EMPTY;
+}
+
+// Returns a node to the pool
+static void freeNode(int node){
+	counts[node] = arena->freeNode;
+	arena->freeNode = node;
+	arena->nodesInUse--;
+}
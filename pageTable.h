@@ -0,0 +1,50 @@
+// pageTable.h was created by Mark Renard on 5/11/2020.
+//
+// This file defines the page tables of assignment 6. Each process has a radix
+// tree of page tables with PAGE_TABLE_FANOUT entries per node. The root of
+// each tree is kept in an array indexed by simPid, and every other node comes
+// from a pool in shared memory. A node is returned to the pool once no valid
+// page is left below it, so the memory used follows the pages in memory
+// rather than the size of the address spaces.
+
+#ifndef PAGETABLE_H
+#define PAGETABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "constants.h"
+
+// Defines an entry in the page table of each process
+typedef struct pageTableEntry{
+	int frameNumber;
+	char valid;
+	char dirty;
+} PageTableEntry;
+
+// Tracks the pool of nodes, stored at the start of the page tables' part of
+// shared memory
+typedef struct pageTableArena {
+	int freeNode;		// First node on the free list or EMPTY
+	int nodesInUse;		// Nodes taken from the pool
+	int peakNodes;		// Most nodes taken from the pool at once
+} PageTableArena;
+
+size_t pageTableArenaSize(int numPcbs, int numFrames, int maxPages);
+void setPageTables(PageTableArena * arena, int numPcbs, int numFrames,
+		   int maxPages);
+void initPageTables();
+int getMaxPages();
+int getPageTableDepth();
+PageTableEntry * lookupPage(int simPid, int pageNum);
+PageTableEntry * walkPageTable(int simPid, int pageNum, int * levelsRead);
+void mapPage(int simPid, int pageNum, int frameNum);
+void unmapPage(int simPid, int pageNum);
+int nextValidPage(int simPid, int fromPage);
+int countResidentPages(int simPid);
+long getLevelReads(int level);
+long getLevelMisses(int level);
+size_t getPageTableBytes(bool peak);
+size_t getFlatPageTableBytes();
+
+#endif
@@ -0,0 +1,111 @@
+// pageout.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains the pageout daemon's choice of frames to clean and its
+// accounting. Its hand sweeps the dirty frames, skipping those referenced
+// since it last passed them, and oss writes each frame it picks back on an
+// idle disk channel. The time each write takes is kept until the frame's
+// page is evicted, when a write-back was saved from the fault's path, or
+// until it is written again or freed, when the write was wasted. A page
+// evicted before its write completes saves only the part already done, since
+// the page read into its frame waits for the rest.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "constants.h"
+#include "pageout.h"
+#include "perrorExit.h"
+#include "stats.h"
+
+// Prototypes
+static void pageoutWasted(int frameNum);
+
+// Static global variables
+static int low = 0;		// Clean frames below which the daemon starts
+static int high = 0;		// Clean frames at which the daemon stops
+static bool running = false;	// Whether the daemon is cleaning frames
+static int hand = 0;		// Frame the daemon's hand points to
+static Time * writeTimes = NULL;// Time each frame's cleaning took, or 0
+static Time * writeEnds = NULL;	// Time each frame's cleaning completes
+
+// Sets the watermarks, where a low watermark of 0 disables the daemon
+void initPageout(int numFrames, int lowWatermark, int highWatermark){
+	int i;
+
+	low = lowWatermark;
+	high = highWatermark;
+	if (low == 0) return;
+
+	writeTimes = malloc(sizeof(Time) * numFrames);
+	writeEnds = malloc(sizeof(Time) * numFrames);
+	if (writeTimes == NULL || writeEnds == NULL)
+		perrorExit("initPageout failed to allocate write times");
+
+	for (i = 0; i < numFrames; i++){
+		writeTimes[i] = 0;
+		writeEnds[i] = 0;
+	}
+}
+
+// Frees the write times
+void freePageout(){
+	free(writeTimes);
+	free(writeEnds);
+	writeTimes = NULL;
+	writeEnds = NULL;
+}
+
+// Returns a dirty frame for the daemon to clean, or EMPTY if enough frames
+// are clean or none can be cleaned
+int nextPageout(FrameBits * bits){
+	int clean = bits->numFrames - bits->numDirty;
+
+	if (low == 0) return EMPTY;
+
+	if (clean < low) running = true;
+	if (clean >= high) running = false;
+	if (!running) return EMPTY;
+
+	return sweepDirty(bits, &hand);
+}
+
+// Counts a frame the daemon started writing back, which completes at end
+void pageoutStarted(int frameNum, Time start, Time end){
+	statsCount(STAT_PAGEOUTS);
+	writeTimes[frameNum] = end > start ? end - start : 1;
+	writeEnds[frameNum] = end;
+}
+
+// Counts a cleaned frame written again as a wasted write
+void pageoutDirtied(int frameNum){
+	if (writeTimes != NULL && writeTimes[frameNum] != 0)
+		pageoutWasted(frameNum);
+}
+
+// Counts the eviction of a cleaned frame as a write-back saved, less the
+// time its write has left to run
+void pageoutEvicted(int frameNum, Time now){
+	Time saved;	// Time of the write done before now
+
+	if (writeTimes == NULL || writeTimes[frameNum] == 0) return;
+
+	saved = writeTimes[frameNum];
+	if (writeEnds[frameNum] > now)
+		saved -= writeEnds[frameNum] - now;
+
+	statsCount(STAT_PAGEOUT_SAVES);
+	statsAdd(STAT_PAGEOUT_SAVED_TIME, saved);
+	writeTimes[frameNum] = 0;
+}
+
+// Counts a cleaned frame freed by a terminating process as a wasted write
+void pageoutFreed(int frameNum){
+	if (writeTimes != NULL && writeTimes[frameNum] != 0)
+		pageoutWasted(frameNum);
+}
+
+// Counts a write that saved no write-back
+static void pageoutWasted(int frameNum){
+	statsCount(STAT_WASTED_PAGEOUTS);
+	writeTimes[frameNum] = 0;
+}
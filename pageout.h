@@ -0,0 +1,22 @@
+// pageout.h was created by Mark Renard on 5/12/2020.
+//
+// This file contains headers for the pageout daemon, which writes dirty
+// frames back to disk ahead of time so that faults mostly find clean
+// victims. The daemon starts when fewer frames than the low watermark are
+// clean and stops once the high watermark is reached.
+
+#ifndef PAGEOUT_H
+#define PAGEOUT_H
+
+#include "clock.h"
+#include "frameBits.h"
+
+void initPageout(int numFrames, int lowWatermark, int highWatermark);
+void freePageout();
+int nextPageout(FrameBits * bits);
+void pageoutStarted(int frameNum, Time start, Time end);
+void pageoutDirtied(int frameNum);
+void pageoutEvicted(int frameNum, Time now);
+void pageoutFreed(int frameNum);
+
+#endif
@@ -2,37 +2,36 @@
 // 4/29/2020.
 //
 // This file contains functions for initializing and resetting process control
-// block structures that contain page tables.
+// block structures.
 
 #include "constants.h"
+#include "pageTable.h"
 #include "pcb.h"
 #include "queue.h"
 #include "randomGen.h"
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
-static const Clock MEM_ACCESS_TIME = {MEM_ACCESS_SEC, MEM_ACCESS_NS};
+static const Time MEM_ACCESS_TIME = TIME(MEM_ACCESS_SEC, MEM_ACCESS_NS);
 
 // Sets non-queue values to defaults
 static void setDefaults(PCB * pcb){
 	pcb->realPid = EMPTY;
 
-	// Unsets valid and dirty indicators in page table
-	int i = 0;
-	for( ; i < MAX_ALLOC_PAGES; i++){
-		pcb->pageTable[i].valid = 0;
-		pcb->pageTable[i].dirty = 0;
-	}
-
 	// Reference endTime is not set
 	pcb->lastReference.completionTimeIsSet = false;
 
+	// No batch of requests is pending
+	pcb->batch.count = 0;
+	pcb->batchIndex = 0;
+
 	// Assigns random length
-	pcb->lengthRegister = randInt(MIN_ALLOC_PAGES, MAX_ALLOC_PAGES);
+	pcb->lengthRegister = randInt(MIN_ALLOC_PAGES, getMaxPages());
 
 	// Initializes statistics
-	pcb->totalAccessTime = zeroClock();
+	pcb->totalAccessTime = 0;
 	pcb->totalReferences = 0;
 
 }
@@ -52,11 +51,16 @@ void initPcb(PCB * pcb, int simPid){
 	pcb->previous = NULL;
 }
 
-// Initializes a pcb not assigned to a running process and returns its simPid
-int getFreePcbIndex(PCB * pcbs){
-	int simPid;
-	for (simPid = 0; simPid < MAX_RUNNING; simPid++){
+// Returns the simPid of a pcb not assigned to a running process
+int getFreePcbIndex(PCB * pcbs, int numPcbs){
+	static int start = 0;	// Index after the last pcb assigned
+	int i, simPid;
+
+	// Checks each pcb once, starting after the last pcb assigned
+	for (i = 0; i < numPcbs; i++){
+		simPid = (start + i) % numPcbs;
 		if (pcbs[simPid].realPid == EMPTY){
+			start = (simPid + 1) % numPcbs;
 			return simPid;
 		}
 	}
@@ -66,9 +70,9 @@ int getFreePcbIndex(PCB * pcbs){
 }
 
 // Initializes the shared array of pcbs to default values
-void initPcbArray(PCB * pcbArr){
+void initPcbArray(PCB * pcbArr, int numPcbs){
 	int i;
-	for (i = 0; i < MAX_RUNNING; i++){
+	for (i = 0; i < numPcbs; i++){
 #ifdef DEBUG
 		fprintf(stderr, "Attempting to initialize pcb for P%d\n", i);
 #endif
@@ -86,28 +90,36 @@ void resetPcb(PCB * pcb){
 
 // Sets the logical address and type of the last memory reference
 void setLastReferenceInPcb(PCB * pcb, int address, RefType type, 
-			   Clock startTime){
+			   unsigned int seq, Time startTime){
 	pcb->lastReference.address = address;
 	pcb->lastReference.type = type;
-	copyTime(&pcb->lastReference.startTime, startTime);
+	pcb->lastReference.seq = seq;
+	pcb->lastReference.startTime = startTime;
+	pcb->lastReference.wroteVictim = false;
+}
+
+// Copies a batch of requests to the pcb to be processed from the first
+void setBatchInPcb(PCB * pcb, const RefBatch * batch){
+	pcb->batch.count = batch->count;
+	memcpy(pcb->batch.msgs, batch->msgs, batch->count * sizeof(RefMsg));
+	pcb->batchIndex = 0;
 }
 
 // Sets the time at which an I/O operation will complete
-void setIoCompletionTimeInPcb(PCB * pcb, Clock completeTime){
-	copyTime(&pcb->lastReference.pageCompleteTime, completeTime);
+void setIoCompletionTimeInPcb(PCB * pcb, Time completeTime){
+	pcb->lastReference.pageCompleteTime = completeTime;
 	pcb->lastReference.completionTimeIsSet = true;
 }
 
 // Adds access time to accululator and increments the number of accesses
-void completeReferenceInPcb(PCB * pcb, Clock refCompletionTime){
+void completeReferenceInPcb(PCB * pcb, Time refCompletionTime){
 
 	// Sets end time for last reference
-	copyTime(&pcb->lastReference.endTime, refCompletionTime);
+	pcb->lastReference.endTime = refCompletionTime;
 
 	// Adds elapsed time durring last reference to total
-	Clock elapsed = clockDiff(pcb->lastReference.endTime,
-				  pcb->lastReference.startTime);
-	incrementClock(&pcb->totalAccessTime, elapsed);
+	pcb->totalAccessTime += pcb->lastReference.endTime
+				- pcb->lastReference.startTime;
 
 	// Increments total number of references
 	pcb->totalReferences += 1;
@@ -117,6 +129,8 @@ void completeReferenceInPcb(PCB * pcb, Clock refCompletionTime){
 }
 
 // Returns effective memory access time
-Clock getEatFromPcb(const PCB * pcb){
-	return clockDiv(pcb->totalAccessTime, pcb->totalReferences);
+Time getEatFromPcb(const PCB * pcb){
+	if (pcb->totalReferences == 0) return 0;
+
+	return pcb->totalAccessTime / pcb->totalReferences;
 }
@@ -1,7 +1,7 @@
 // pcb.h was created by Mark Renard on 4/30/2020.
 //
-// This file defines the page table entry struct and a process control block 
-// specific to assignment 6.
+// This file defines a process control block specific to assignment 6. Page
+// tables are kept apart from the pcbs, in the trees of pageTable.c.
 
 #ifndef PCB_H
 #define PCB_H
@@ -11,13 +11,7 @@
 
 #include "clock.h"
 #include "constants.h"
-
-// Defines an entry in the page table of each process
-typedef struct pageTableEntry{
-	char valid;
-	char dirty;
-	unsigned char frameNumber;
-} PageTableEntry;
+#include "qMsg.h"
 
 // Defines types of reference a process can make
 typedef enum RefType {READ_REFERENCE, WRITE_REFERENCE} RefType;
@@ -26,12 +20,14 @@ typedef enum RefType {READ_REFERENCE, WRITE_REFERENCE} RefType;
 typedef struct reference {
 	int address;		// The referenced virtual address
 	RefType type;		// Whether the reference is read or write
+	unsigned int seq;	// Sequence number of the request
 
-	Clock startTime;	// The time the memory reference started
-	Clock pageCompleteTime; // The time paging operations completed
-	Clock endTime;		// The time the reference was comlpeted
+	Time startTime;		// The time the memory reference started
+	Time pageCompleteTime;	// The time paging operations completed
+	Time endTime;		// The time the reference was comlpeted
 
 	bool completionTimeIsSet;	// Whether pageCompletionTime is set
+	bool wroteVictim;		// Whether paging wrote a dirty victim
 } Reference;
 
 struct queue;
@@ -40,16 +36,19 @@ struct queue;
 typedef struct pcb{
 	int simPid;			// The simPid of the process
 	pid_t realPid;			// The actual pid of the process
+	int processNum;			// Order in which it was launched
 
-	// Page table for the process
-	PageTableEntry pageTable[MAX_ALLOC_PAGES];
 	int lengthRegister;		// The number of allocated pages
 
 	// The last memory reference the process made
 	Reference lastReference;
 
+	// Requests in the process's last batch and the index of the next one
+	RefBatch batch;
+	unsigned int batchIndex;
+
 	// Statistics
-	Clock totalAccessTime;		// Total time spent accessing memory
+	Time totalAccessTime;		// Total time spent accessing memory
 	unsigned int totalReferences;	// Total number of memory references
 
 	// Fields used in Queue for paging I/O
@@ -61,13 +60,15 @@ typedef struct pcb{
 
 // Function prototypes
 void initPcb(PCB *, int simPid);
-int getFreePcbIndex(PCB * pcbs);
-void initPcbArray(PCB *);
+int getFreePcbIndex(PCB * pcbs, int numPcbs);
+void initPcbArray(PCB *, int numPcbs);
 void resetPcb(PCB *);
-void setLastReferenceInPcb(PCB *, int address, RefType type, Clock startTime);
-void setIoCompletionTimeInPcb(PCB * pcb, Clock endTime);
-void completeReferenceInPcb(PCB * pcb, Clock refCompletionTime);
-Clock getEatFromPcb(const PCB * pcb);
+void setLastReferenceInPcb(PCB *, int address, RefType type, unsigned int seq,
+			   Time startTime);
+void setBatchInPcb(PCB * pcb, const RefBatch * batch);
+void setIoCompletionTimeInPcb(PCB * pcb, Time endTime);
+void completeReferenceInPcb(PCB * pcb, Time refCompletionTime);
+Time getEatFromPcb(const PCB * pcb);
 
 #include "queue.h"
 #endif
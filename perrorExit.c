@@ -1,17 +1,23 @@
 // perrorExit.c was created by Mark Renard on 2/21/2020
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <signal.h>
 
 char * exeName;
+bool signalGroup = true;	// Whether errors interrupt the process group
 
 // This function prints an error message in a standard format and exits.
+// Programs run under oss interrupt the process group so that oss cleans up,
+// while standalone tools clear signalGroup and exit by themselves.
 void perrorExit(char * msg){
 	char errmsg[100];
 	sprintf(errmsg, "%s: Error: %s", exeName, msg);
 	perror(errmsg);
 
+	if (!signalGroup) exit(1);
+
 	kill(0, SIGINT);
 }
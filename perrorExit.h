@@ -2,6 +2,11 @@
 //
 // This file contains a header for a function which outputs an error message
 // in a standard format using perror and then exits with error code 1.
+// Programs that run outside oss set signalGroup to false, so that an error
+// exits only their own process rather than interrupting the process group.
+
+#include <stdbool.h>
 
 extern char * exeName;
+extern bool signalGroup;
 void perrorExit(char * msg);
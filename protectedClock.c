@@ -1,49 +1,39 @@
 // protectedClock.c was created by Mark Renard at some point in the recent past.
 //
 // This file contains function implementations for accessing and mutating the
-// values of a logical clock protected by a semaphore.
+// values of a logical clock shared by multiple processes. The clock is a
+// count of nanoseconds, so it is advanced with one atomic add and read with
+// one atomic load.
 
-#include <pthread.h>
+#include <stdatomic.h>
 
 #include "clock.h"
 #include "protectedClock.h"
 
-// Initializes semaphore protecting the clock
-static void initializeSemaphore(pthread_mutex_t * mutex){
-        pthread_mutexattr_t attributes; // mutex attributes struct
-
-        // Initializes mutex attributes struct
-        pthread_mutexattr_init(&attributes);
-
-        // Specifies that the semaphore can be used by multiple processes
-        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
-
-        // Initializes the mutex with the attributes struct
-        pthread_mutex_init(mutex, &attributes);
-}
-
 // Initializes a ProtectedClock
 void initPClock(ProtectedClock * pClockPtr){
-	pClockPtr->time = zeroClock();
-	initializeSemaphore(&pClockPtr->sem);
+	atomic_store_explicit(&pClockPtr->ns, 0, memory_order_relaxed);
 }
 
-// Locks and unlocks a semaphore to increment a ProtectedClock
-void incrementPClock(ProtectedClock * pClockPtr, Clock increment){
-	pthread_mutex_lock(&pClockPtr->sem);
-	incrementClock(&pClockPtr->time, increment);
-	pthread_mutex_unlock(&pClockPtr->sem);
+// Atomically adds an increment to a ProtectedClock
+void incrementPClock(ProtectedClock * pClockPtr, Time increment){
+	atomic_fetch_add_explicit(&pClockPtr->ns, increment,
+				  memory_order_release);
 }
 
-// Returns the value of the time in a ProtectedClock
-Clock getPTime(ProtectedClock * pClockPtr){
-	Clock time;
-
-	pthread_mutex_lock(&pClockPtr->sem);
-	copyTime(&time, pClockPtr->time);
-	pthread_mutex_unlock(&pClockPtr->sem);
+// Moves a ProtectedClock forward to a time unless it has already passed it
+void advancePClock(ProtectedClock * pClockPtr, Time time){
+	Time now = atomic_load_explicit(&pClockPtr->ns, memory_order_relaxed);
 
-	return time;
+	// Retries if another process changes the clock between load and swap
+	while (now < time
+	       && !atomic_compare_exchange_weak_explicit(&pClockPtr->ns, &now,
+							 time,
+							 memory_order_release,
+							 memory_order_relaxed));
 }
 
-
+// Returns the value of the time in a ProtectedClock
+Time getPTime(ProtectedClock * pClockPtr){
+	return atomic_load_explicit(&pClockPtr->ns, memory_order_acquire);
+}
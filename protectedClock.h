@@ -1,22 +1,26 @@
 // protectedClock.h was created by Mark Renard on 4/11/2020.
 //
 // This file defines a type used to extend the base clock type to allow
-// mutually exclusive access by multiple processes for writing.
+// access by multiple processes for writing. The time is a single count of
+// nanoseconds updated atomically, alone on its cache line so that reading it
+// does not contend with writes to the frame table.
 
 #ifndef PROTECTEDCLOCK_H
 #define PROTECTEDCLOCK_H
 
+#include <stdatomic.h>
 #include <stdio.h>
-#include <pthread.h>
+
 #include "clock.h"
+#include "constants.h"
 
 typedef struct protectedClock {
-	Clock time;
-	pthread_mutex_t sem;
+	_Atomic Time ns __attribute__((aligned(CACHE_LINE_SIZE)));
 } ProtectedClock;
 
 void initPClock(ProtectedClock * pClockPtr);
-void incrementPClock(ProtectedClock * pClockPtr, Clock increment);
-Clock getPTime(ProtectedClock * pClockPtr);
+void incrementPClock(ProtectedClock * pClockPtr, Time increment);
+void advancePClock(ProtectedClock * pClockPtr, Time time);
+Time getPTime(ProtectedClock * pClockPtr);
 
 #endif
@@ -4,6 +4,7 @@
 // use of a message queue to send and recieve messages.
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <sys/msg.h>
 #include <sys/stat.h>
@@ -21,47 +22,54 @@ int getMessageQueue(int key, int flags){
 	return msgQueueId;
 }
 
+// Returns the number of bytes of a batch that hold its payloads
+static size_t batchSize(const RefBatch * batch){
+	return offsetof(RefBatch, msgs) + batch->count * sizeof(RefMsg);
+}
+
 // Adds a message to the message queue with the specified message queue id
-void sendMessage(int msgQueueId, const char * msgText, long int type){
+void sendMessage(int msgQueueId, const RefBatch * batch, long int type){
 	qMsg msg;	// Buffer for the message to be sent
 
-	// Initializes message
+	// Initializes message, copying only the payloads in the batch
 	msg.type = type;
-	strcpy(msg.str, msgText);
+	memcpy(&msg.batch, batch, batchSize(batch));
 
-	// Sends message
-	if ((msgsnd(msgQueueId, (const void *)&msg, sizeof(msg.str), 0)) == -1){
+	// Sends message, retrying if interrupted by a signal
+	while ((msgsnd(msgQueueId, (const void *)&msg, batchSize(batch), 0)) \
+		== -1){
+		if (errno == EINTR) continue;
 		fprintf(stderr, "Couldn't send msg of type %ld\n", type);
-		fprintf(stderr, "Msg: %s\n", msg.str);
+		fprintf(stderr, "Msg: %u payloads\n", batch->count);
 		perrorExit("Couldn't send message");
 	}
 }
 
 // Blocks until a message of the selected type is recieved in the selected queue
-void waitForMessage(int msgQueueId, char * msgText, long int type){
+void waitForMessage(int msgQueueId, RefBatch * batch, long int type){
 	qMsg msg;	// Buffer for message to be received
 
 	// Waits for message
 	if ((msgrcv(msgQueueId, (void *)&msg, \
-		sizeof(msg.str), type, 0)) == -1)
+		sizeof(msg.batch), type, 0)) == -1)
 			perrorExit("Error waiting for message");
 
-	// Copies message text
-	if (msgText != NULL)
-		strcpy(msgText, msg.str);
+	// Copies message payloads
+	if (batch != NULL)
+		memcpy(batch, &msg.batch, batchSize(&msg.batch));
 }
 
 // Checks to see if a message has been sent, doesn't block if not
-int getMessage(int msgQueueId, char * msgText, long int * type ){
+int getMessage(int msgQueueId, RefBatch * batch, long int * type ){
 	qMsg msg;	// Buffer for message to be recieved
 
-	if(msgrcv(msgQueueId, (void *)&msg, sizeof(msg.str), 0, IPC_NOWAIT) \
+	if(msgrcv(msgQueueId, (void *)&msg, sizeof(msg.batch), 0, IPC_NOWAIT) \
 		== -1){
 		if (errno == ENOMSG) return 0;
 		else perrorExit("Error getting message");
 	}
 
-	strcpy(msgText, msg.str);
+	memcpy(batch, &msg.batch, batchSize(&msg.batch));
 	*type = msg.type;
 
 	return 1;
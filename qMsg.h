@@ -6,18 +6,35 @@
 #ifndef QMSG_H
 #define QMSG_H
 
+#include "clock.h"
 #include "constants.h"
 
+// Defines the kinds of message passed between oss and user processes
+typedef enum msgOp {READ_MSG, WRITE_MSG, TERMINATE_MSG, REPLY_MSG} MsgOp;
+
+// Fixed-width binary payload of a message, copied without string conversion
+typedef struct refMsg {
+	unsigned int op;	// The MsgOp of the message
+	int address;		// The referenced logical address
+	unsigned int seq;	// Sequence number of the request
+	Time sent;		// Time the message was sent
+} RefMsg;
+
+// Payloads sent together in one message, only count of which are copied
+typedef struct refBatch {
+	unsigned int count;		// Number of payloads in the batch
+	RefMsg msgs[MAX_BATCH_SIZE];	// Payloads in the order they were made
+} RefBatch;
+
 typedef struct qmsg {
 	long int type;
-	char str[MSG_SZ];
+	RefBatch batch;
 } qMsg;
 
 int getMessageQueue(int key, int flags);
-void sendMessage(int msgQueueId, const char * msgText, long int type);
-void waitForMessage(int msgQueueId, char * msgText, long int type);
-int getMessage(int msgQueueId, char * msgText, long int * type);
+void sendMessage(int msgQueueId, const RefBatch * batch, long int type);
+void waitForMessage(int msgQueueId, RefBatch * batch, long int type);
+int getMessage(int msgQueueId, RefBatch * batch, long int * type);
 void removeMessageQueue(int msgQueueId);
 
 #endif
-
@@ -0,0 +1,192 @@
+// readAhead.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains the fault streams of processes and the accounting of
+// the pages read ahead for them. A process's faults form a stream once two
+// in a row are the same number of pages apart, and each later fault on the
+// stream reads ahead up to its window of pages along the stride. A fault at
+// the page just past those read ahead doubles the window, and each page read
+// ahead that is evicted unreferenced halves it. Pages read ahead are counted
+// as used when first referenced, or as wasted when evicted or freed first.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+#include "readAhead.h"
+#include "stats.h"
+
+// Stores the faults of a process and the pages read ahead with its fault
+typedef struct stream {
+	int lastPage;	// Page of the process's last fault, or EMPTY
+	int stride;	// Pages between its last two faults off the stream
+	int nextPage;	// Page along the stride after the last one read
+	int window;	// Pages read ahead with a fault on the stream
+	int * frames;	// Frames of the pages read ahead with the fault
+	int numFrames;	// Length of frames
+} Stream;
+
+// Prototypes
+static void resetStream(Stream * stream);
+
+// Static global variables
+static int maxWindow = 0;	// Largest window, or 0 for no read-ahead
+static Stream * streams = NULL;	// Stream of each pcb's process
+static int numStreams = 0;	// Length of streams
+static int * owners = NULL;	// Process each frame's unreferenced page was
+				// read ahead for, or EMPTY
+static int inFlight = 0;	// Pages being read ahead
+
+// Allocates a stream for each pcb and an owner for each frame, where a
+// maximum window of 0 disables read-ahead
+void initReadAhead(int numPcbs, int numFrames, int maxWindowPages){
+	int i;
+
+	maxWindow = maxWindowPages;
+	if (maxWindow == 0) return;
+
+	streams = malloc(sizeof(Stream) * numPcbs);
+	owners = malloc(sizeof(int) * numFrames);
+	if (streams == NULL || owners == NULL)
+		perrorExit("initReadAhead failed to allocate streams");
+
+	for (i = 0; i < numPcbs; i++){
+		streams[i].frames = malloc(sizeof(int) * maxWindow);
+		if (streams[i].frames == NULL)
+			perrorExit("initReadAhead failed to allocate frames");
+		resetStream(&streams[i]);
+	}
+	numStreams = numPcbs;
+
+	for (i = 0; i < numFrames; i++)
+		owners[i] = EMPTY;
+}
+
+// Frees the streams and owners
+void freeReadAhead(){
+	int i;
+
+	for (i = 0; i < numStreams; i++)
+		free(streams[i].frames);
+
+	free(streams);
+	free(owners);
+	streams = NULL;
+	owners = NULL;
+	numStreams = 0;
+}
+
+// Records a fault on a process's page and fills pages with those to read
+// ahead with it, returning how many there are
+int readAheadPages(int simPid, int pageNum, int lengthRegister, int * pages){
+	Stream * stream;
+	bool readAhead;	// Whether the last fault read pages ahead
+	bool onStream;	// Whether the fault follows the stride
+	int count = 0;	// Pages to read ahead
+	int page;
+
+	if (maxWindow == 0) return 0;
+
+	stream = &streams[simPid];
+	readAhead = stream->nextPage != stream->lastPage + stream->stride;
+	onStream = stream->stride != 0
+		   && (pageNum == stream->nextPage
+		       || pageNum - stream->lastPage == stream->stride);
+
+	// Grows the window when the fault reaches the end of the pages read
+	// ahead, or starts following the distance from the last fault
+	if (onStream && readAhead && pageNum == stream->nextPage)
+		stream->window = 2 * stream->window < maxWindow
+				 ? 2 * stream->window : maxWindow;
+	else if (!onStream && stream->lastPage != EMPTY)
+		stream->stride = pageNum - stream->lastPage;
+
+	stream->lastPage = pageNum;
+	stream->nextPage = pageNum + stream->stride;
+	if (!onStream) return 0;
+
+	for (page = pageNum + stream->stride; count < stream->window
+	     && page >= 0 && page < lengthRegister; page += stream->stride)
+		pages[count++] = page;
+
+	return count;
+}
+
+// Records that a page is being read ahead into a frame with the process's
+// fault
+void readAheadIssued(int simPid, int pageNum, int frameNum){
+	Stream * stream = &streams[simPid];
+
+	stream->frames[stream->numFrames++] = frameNum;
+	stream->nextPage = pageNum + stream->stride;
+	owners[frameNum] = simPid;
+	inFlight++;
+	statsCount(STAT_PREFETCHES);
+}
+
+// Points frames to the frames read ahead with the process's fault, which has
+// completed, and returns how many there are
+int readAheadArrived(int simPid, const int ** frames){
+	Stream * stream;
+	int count;
+
+	if (maxWindow == 0) return 0;
+
+	stream = &streams[simPid];
+	count = stream->numFrames;
+	*frames = stream->frames;
+	stream->numFrames = 0;
+	inFlight -= count;
+
+	return count;
+}
+
+// Returns the number of pages being read ahead, whose frames are busy
+int readAheadInFlight(){
+	return inFlight;
+}
+
+// Counts the first reference to a page read ahead as a use
+void readAheadReferenced(int frameNum){
+	if (owners == NULL || owners[frameNum] == EMPTY) return;
+
+	statsCount(STAT_PREFETCH_HITS);
+	owners[frameNum] = EMPTY;
+}
+
+// Counts the eviction of an unreferenced page read ahead as wasted, halving
+// the window of the process it was read for
+void readAheadEvicted(int frameNum){
+	Stream * stream;
+
+	if (owners == NULL || owners[frameNum] == EMPTY) return;
+
+	stream = &streams[owners[frameNum]];
+	if (stream->window > 1) stream->window /= 2;
+
+	statsCount(STAT_WASTED_PREFETCHES);
+	owners[frameNum] = EMPTY;
+}
+
+// Counts an unreferenced page read ahead freed by its process as wasted
+void readAheadFreed(int frameNum){
+	if (owners == NULL || owners[frameNum] == EMPTY) return;
+
+	statsCount(STAT_WASTED_PREFETCHES);
+	owners[frameNum] = EMPTY;
+}
+
+// Forgets the stream of a terminated process
+void readAheadTerminated(int simPid){
+	if (maxWindow != 0) resetStream(&streams[simPid]);
+}
+
+// Empties a stream, setting its window to the initial size
+static void resetStream(Stream * stream){
+	stream->lastPage = EMPTY;
+	stream->stride = 0;
+	stream->nextPage = EMPTY;
+	stream->window = READ_AHEAD_WINDOW < maxWindow
+			 ? READ_AHEAD_WINDOW : maxWindow;
+	stream->numFrames = 0;
+}
@@ -0,0 +1,23 @@
+// readAhead.h was created by Mark Renard on 5/12/2020.
+//
+// This file contains headers for read-ahead, which detects processes that
+// fault on pages a constant stride apart and reads the pages further along
+// the stride in the same transfer as the fault. Each process has a window of
+// pages read ahead, which grows while its faults follow the stride and
+// shrinks when a page read ahead is evicted before it was referenced.
+
+#ifndef READAHEAD_H
+#define READAHEAD_H
+
+void initReadAhead(int numPcbs, int numFrames, int maxWindowPages);
+void freeReadAhead();
+int readAheadPages(int simPid, int pageNum, int lengthRegister, int * pages);
+void readAheadIssued(int simPid, int pageNum, int frameNum);
+int readAheadArrived(int simPid, const int ** frames);
+int readAheadInFlight();
+void readAheadReferenced(int frameNum);
+void readAheadEvicted(int frameNum);
+void readAheadFreed(int frameNum);
+void readAheadTerminated(int simPid);
+
+#endif
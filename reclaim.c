@@ -0,0 +1,130 @@
+// reclaim.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains the free frame pool, a stack of the frames no page
+// holds, and the watermarks that decide when oss evicts frames into it. A
+// fault pops a frame in constant time, and the victims the reclaimer takes
+// while the pool is below its high watermark are evicted together whether or
+// not faults are queued. Clean victims join the pool at once, while dirty
+// ones wait in a queue for idle disk channels to write them back. Dirty
+// victims are counted with the pool until they are written back, so the
+// reclaimer does not evict more frames to cover them.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+#include "reclaim.h"
+
+// Static global variables
+static int frames = 0;		// Frames in main memory
+static int min = 0;		// Free frames a fault cannot take
+static int low = 0;		// Free frames below which the reclaimer wakes
+static int high = 0;		// Free frames at which the reclaimer sleeps
+static bool running = false;	// Whether the reclaimer is evicting frames
+static int * pool = NULL;	// Stack of free frames
+static int count = 0;		// Frames in the pool
+static int writing = 0;		// Reclaimed frames still being written back
+static int * queued = NULL;	// Ring of dirty victims awaiting a channel
+static long * queuedSlots = NULL;// Slots they are written back to
+static int numQueued = 0;	// Victims in the ring
+static int front = 0;		// Index of the victim queued first
+
+// Sets the watermarks and fills the pool with every frame, so that faults
+// take the lowest frames first, where a low watermark of 0 disables the pool
+void initReclaim(int numFrames, int minWatermark, int lowWatermark,
+		 int highWatermark){
+	int i;
+
+	frames = numFrames;
+	min = minWatermark;
+	low = lowWatermark;
+	high = highWatermark;
+	if (low == 0) return;
+
+	pool = malloc(sizeof(int) * numFrames);
+	queued = malloc(sizeof(int) * numFrames);
+	queuedSlots = malloc(sizeof(long) * numFrames);
+	if (pool == NULL || queued == NULL || queuedSlots == NULL)
+		perrorExit("initReclaim failed to allocate the free pool");
+
+	for (i = 0; i < numFrames; i++)
+		pool[i] = numFrames - 1 - i;
+	count = numFrames;
+}
+
+// Frees the pool and the queue of dirty victims
+void freeReclaim(){
+	free(pool);
+	free(queued);
+	free(queuedSlots);
+	pool = NULL;
+	queued = NULL;
+	queuedSlots = NULL;
+}
+
+// Returns a free frame for a fault, or EMPTY if the fault must evict one
+// itself because the pool is at its min watermark and some frame paged in
+// can still be evicted. Without a pool, searches the allocated bits instead
+int takeFreeFrame(FrameBits * bits, int pagingIn){
+	if (pool == NULL) return findFreeFrame(bits);
+	if (count == 0 || (count <= min && victimAvailable(pagingIn)))
+		return EMPTY;
+
+	return pool[--count];
+}
+
+// Puts a frame freed by a terminating process or the reclaimer in the pool
+void returnFreeFrame(int frameNum){
+	if (pool != NULL) pool[count++] = frameNum;
+}
+
+// Returns whether the reclaimer should evict another frame, which it does
+// from when the pool falls below the low watermark until it reaches the high
+// one, as long as some frame paged in is left to evict
+bool reclaimNeeded(int pagingIn){
+	int available = count + writing;
+
+	if (pool == NULL) return false;
+
+	if (available < low) running = true;
+	if (available >= high) running = false;
+
+	return running && available + pagingIn < frames;
+}
+
+// Returns whether some frame holds a page that could be evicted, given the
+// number of frames being paged in, which are neither free nor evictable
+bool victimAvailable(int pagingIn){
+	return count + writing + pagingIn < frames;
+}
+
+// Queues a dirty victim to be written back to its slot before it is free
+void reclaimWriteQueued(int frameNum, long slot){
+	int back = (front + numQueued++) % frames;
+
+	queued[back] = frameNum;
+	queuedSlots[back] = slot;
+	writing++;
+}
+
+// Removes and returns the dirty victim queued first, setting slot to the slot
+// it is written back to, or returns EMPTY if none is queued
+int nextQueuedWrite(long * slot){
+	int frameNum;
+
+	if (numQueued == 0) return EMPTY;
+
+	frameNum = queued[front];
+	*slot = queuedSlots[front];
+	front = (front + 1) % frames;
+	numQueued--;
+
+	return frameNum;
+}
+
+// Puts a reclaimed frame that was written back in the pool
+void reclaimWriteFinished(int frameNum){
+	writing--;
+	returnFreeFrame(frameNum);
+}
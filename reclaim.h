@@ -0,0 +1,29 @@
+// reclaim.h was created by Mark Renard on 5/12/2020.
+//
+// This file contains headers for the free frame pool and its reclaimer,
+// which evicts frames into the pool ahead of faults. The reclaimer wakes when
+// fewer frames than the low watermark are free and stops once the high
+// watermark is reached, whatever the state of the paging queue, and dirty
+// victims are written back as disk channels fall idle. A fault takes a frame
+// from the pool unless the pool is at its min watermark, when the fault
+// evicts a victim itself.
+
+#ifndef RECLAIM_H
+#define RECLAIM_H
+
+#include <stdbool.h>
+
+#include "frameBits.h"
+
+void initReclaim(int numFrames, int minWatermark, int lowWatermark,
+		 int highWatermark);
+void freeReclaim();
+int takeFreeFrame(FrameBits * bits, int pagingIn);
+void returnFreeFrame(int frameNum);
+bool reclaimNeeded(int pagingIn);
+bool victimAvailable(int pagingIn);
+void reclaimWriteQueued(int frameNum, long slot);
+int nextQueuedWrite(long * slot);
+void reclaimWriteFinished(int frameNum);
+
+#endif
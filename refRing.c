@@ -0,0 +1,131 @@
+// refRing.c was created by Mark Renard on 5/7/2020.
+//
+// This file contains functions for passing memory reference requests from a
+// user process to oss through a lock-free ring in shared memory. Each ring has
+// exactly one producer (the user process) and one consumer (oss), so acquire
+// and release ordering on the head and tail indices is all that is required.
+// A user process waiting for a reply spins briefly, then sleeps on a futex.
+// oss sleeps on the doorbell futex while it has nothing to do.
+
+#include <linux/futex.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "refRing.h"
+
+// Initializes a ring to empty with no replies sent
+void initRing(RefRing * ring){
+	atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+	atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+	atomic_store_explicit(&ring->replies, 0, memory_order_relaxed);
+	atomic_store_explicit(&ring->waiting, 0, memory_order_relaxed);
+}
+
+// Adds a batch of requests to the ring, yielding the processor until it fits
+void ringPush(RefRing * ring, const RefBatch * batch){
+	unsigned int head;
+	unsigned int i;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+	// Waits for oss to free enough slots
+	while (head + batch->count
+	       - atomic_load_explicit(&ring->tail, memory_order_acquire)
+	       > RING_SIZE)
+		sched_yield();
+
+	// Writes the requests and publishes them to oss together
+	for (i = 0; i < batch->count; i++)
+		ring->slots[(head + i) % RING_SIZE] = batch->msgs[i];
+	atomic_store_explicit(&ring->head, head + batch->count,
+			      memory_order_release);
+}
+
+// Removes all published requests from the ring, returning false if it is empty
+bool ringPop(RefRing * ring, RefBatch * batch){
+	unsigned int head;
+	unsigned int tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+	// Returns if the user process has not published a request
+	if (tail == head)
+		return false;
+
+	// Reads the requests and releases their slots
+	for (batch->count = 0; tail != head; tail++)
+		batch->msgs[batch->count++] = ring->slots[tail % RING_SIZE];
+	atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+	return true;
+}
+
+// Notifies the user process that its last request was completed
+void ringReply(RefRing * ring){
+	atomic_fetch_add(&ring->replies, 1);
+
+	// Wakes the user process only if it went to sleep
+	if (atomic_load(&ring->waiting))
+		syscall(SYS_futex, &ring->replies, FUTEX_WAKE, 1, 
+			NULL, NULL, 0);
+}
+
+// Waits until a reply beyond those already seen is sent
+void ringWaitForReply(RefRing * ring, unsigned int * repliesSeen){
+	int i;
+
+	// Spins briefly since oss usually replies without paging
+	for (i = 0; i < RING_SPINS; i++){
+		if (atomic_load_explicit(&ring->replies, memory_order_acquire)
+		    != *repliesSeen){
+			(*repliesSeen)++;
+			return;
+		}
+	}
+
+	// Sleeps until oss increments the reply count
+	atomic_store(&ring->waiting, 1);
+	while (atomic_load(&ring->replies) == *repliesSeen)
+		syscall(SYS_futex, &ring->replies, FUTEX_WAIT, *repliesSeen,
+			NULL, NULL, 0);
+	atomic_store(&ring->waiting, 0);
+
+	(*repliesSeen)++;
+}
+
+// Initializes a doorbell that has not been rung
+void initDoorbell(Doorbell * doorbell){
+	atomic_store_explicit(&doorbell->rings, 0, memory_order_relaxed);
+	atomic_store_explicit(&doorbell->waiting, 0, memory_order_relaxed);
+}
+
+// Wakes oss after requests were sent if it is sleeping on the doorbell
+void ringDoorbell(Doorbell * doorbell){
+	atomic_fetch_add(&doorbell->rings, 1);
+
+	if (atomic_load(&doorbell->waiting))
+		syscall(SYS_futex, &doorbell->rings, FUTEX_WAKE, 1,
+			NULL, NULL, 0);
+}
+
+// Returns the number of times the doorbell was rung, read before checking
+// for requests so that a request sent after the check is not missed
+unsigned int doorbellRings(Doorbell * doorbell){
+	return atomic_load(&doorbell->rings);
+}
+
+// Sleeps until the doorbell is rung, a signal arrives, or SLEEP_NS passes
+void waitForDoorbell(Doorbell * doorbell, unsigned int ringsSeen){
+	struct timespec timeout = {0, SLEEP_NS};
+
+	atomic_store(&doorbell->waiting, 1);
+	if (atomic_load(&doorbell->rings) == ringsSeen)
+		syscall(SYS_futex, &doorbell->rings, FUTEX_WAIT, ringsSeen,
+			&timeout, NULL, 0);
+	atomic_store(&doorbell->waiting, 0);
+}
@@ -0,0 +1,49 @@
+// refRing.h was created by Mark Renard on 5/7/2020.
+//
+// This file defines a single-producer, single-consumer ring of memory
+// reference requests with a reply counter. One ring is owned by each pcb slot
+// in shared memory so references can bypass the message queues. A process
+// has at most one batch of requests in its ring at a time. A single doorbell
+// lets oss sleep until any process sends a request.
+
+#ifndef REFRING_H
+#define REFRING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "constants.h"
+#include "qMsg.h"
+
+typedef struct refRing {
+	// Index of the next slot written by the user process
+	_Atomic unsigned int head __attribute__((aligned(CACHE_LINE_SIZE)));
+
+	// Index of the next slot read by oss
+	_Atomic unsigned int tail __attribute__((aligned(CACHE_LINE_SIZE)));
+
+	// Number of replies oss has sent to the user process
+	_Atomic unsigned int replies __attribute__((aligned(CACHE_LINE_SIZE)));
+	_Atomic unsigned int waiting;	// Whether the process sleeps on replies
+
+	// Requests written by the user process
+	RefMsg slots[RING_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+} RefRing;
+
+// Counter user processes increment to wake oss after sending requests
+typedef struct doorbell {
+	_Atomic unsigned int rings __attribute__((aligned(CACHE_LINE_SIZE)));
+	_Atomic unsigned int waiting;	// Whether oss sleeps on the doorbell
+} Doorbell;
+
+void initRing(RefRing * ring);
+void ringPush(RefRing * ring, const RefBatch * batch);
+bool ringPop(RefRing * ring, RefBatch * batch);
+void ringReply(RefRing * ring);
+void ringWaitForReply(RefRing * ring, unsigned int * repliesSeen);
+void initDoorbell(Doorbell * doorbell);
+void ringDoorbell(Doorbell * doorbell);
+unsigned int doorbellRings(Doorbell * doorbell);
+void waitForDoorbell(Doorbell * doorbell, unsigned int ringsSeen);
+
+#endif
@@ -0,0 +1,98 @@
+// referenceGen.c was created by Mark Renard on 5/9/2020.
+//
+// This file contains functions that randomly select memory references for a
+// simulated process and decide when it terminates. They were moved from
+// userProgram.c so that oss can host processes without forking them.
+
+#include <stdbool.h>
+
+#include "clock.h"
+#include "constants.h"
+#include "pcb.h"
+#include "randomGen.h"
+#include "referenceGen.h"
+
+static const Time MIN_REF_INTERVAL = TIME(MIN_REF_INTERVAL_SEC,
+					  MIN_REF_INTERVAL_NS);
+static const Time MAX_REF_INTERVAL = TIME(MAX_REF_INTERVAL_SEC,
+					  MAX_REF_INTERVAL_NS);
+
+static int pageSize = PAGE_SIZE;			// Bytes in a page
+static double readProbability = READ_PROBABILITY;	// Chance of a read
+
+// Sets the page size and chance of a read of the references made
+void setReferenceGen(int newPageSize, double newReadProbability){
+	pageSize = newPageSize;
+	readProbability = newReadProbability;
+}
+
+// Randomly determines number of references (900 to 1100 by default)
+void initReferenceGen(ReferenceGen * gen){
+	gen->maxReferences = randInt(MIN_REFERENCES, MAX_REFERENCES);
+	gen->numReferences = 0;
+	gen->referenceTime = 0;
+	gen->continuing = true;
+}
+
+// Returns true if the process should make another reference
+bool referenceGenContinues(ReferenceGen * gen){
+	gen->continuing = gen->numReferences < gen->maxReferences \
+			  || !randBinary(TERMINATION_PROBABILITY);
+
+	return gen->continuing;
+}
+
+// Selects the address and type of the next reference and when to make another
+void nextReference(ReferenceGen * gen, Time now, int lengthRegister,
+		   const double * weights, bool weighted, int * address,
+		   RefType * type){
+
+	delayNextReference(gen, now);
+
+	// Selects read or write reference 
+	*type = randBinary(readProbability) ? READ_REFERENCE : WRITE_REFERENCE;
+	*address = getAddress(lengthRegister, weights, weighted);
+}
+
+// Counts a reference made now and selects when to make another
+void delayNextReference(ReferenceGen * gen, Time now){
+
+	// Updates numReferences
+	gen->numReferences = (gen->numReferences + 1) \
+			     % (gen->maxReferences + 1);
+
+	// Updates reference time
+	gen->referenceTime = now + randomTime(MIN_REF_INTERVAL,
+					      MAX_REF_INTERVAL);
+}
+
+// Returns a reference to an address in memory allocated to the process
+int getAddress(int lengthRegister, const double * weights, bool weighted){
+	int maxPageNum = lengthRegister - 1;
+
+	if (weighted)
+		return weightedAddressSelection(maxPageNum, weights);
+	else
+		return randInt(0, (maxPageNum + 1) * pageSize - 1);
+}
+
+// Returns an address in page n with probability proportional to 1/n
+int weightedAddressSelection(int maxPageNum, const double * weights){
+	double maxVal = weights[maxPageNum];
+	double val = randDouble(0, maxVal);
+
+	// Binary searches the cumulative weights for the first exceeding val
+	int pageNum = 0;
+	int high = maxPageNum;
+	int middle;
+	while (pageNum < high){
+		middle = pageNum + (high - pageNum) / 2;
+		if (weights[middle] > val)
+			high = middle;
+		else
+			pageNum = middle + 1;
+	}
+
+	// Returns a random address in the selected page
+	return pageNum * pageSize + randInt(0, pageSize - 1);
+}
@@ -0,0 +1,32 @@
+// referenceGen.h was created by Mark Renard on 5/9/2020.
+//
+// This file defines the state of a simulated process that randomly generates
+// memory references, shared by userProgram.c and the in-process mode of oss.
+
+#ifndef REFERENCEGEN_H
+#define REFERENCEGEN_H
+
+#include <stdbool.h>
+
+#include "clock.h"
+#include "pcb.h"
+
+// Stores the progress of a process toward its chance of terminating
+typedef struct referenceGen {
+	int maxReferences;	// References before termination chance
+	int numReferences;	// References made since reset
+	Time referenceTime;	// Time at which to make the next reference
+	bool continuing;	// Whether the process makes another reference
+} ReferenceGen;
+
+void setReferenceGen(int pageSize, double readProbability);
+void initReferenceGen(ReferenceGen * gen);
+bool referenceGenContinues(ReferenceGen * gen);
+void nextReference(ReferenceGen * gen, Time now, int lengthRegister,
+		   const double * weights, bool weighted, int * address,
+		   RefType * type);
+void delayNextReference(ReferenceGen * gen, Time now);
+int getAddress(int lengthRegister, const double * weights, bool weighted);
+int weightedAddressSelection(int maxPageNum, const double * weights);
+
+#endif
@@ -0,0 +1,43 @@
+// replacementPolicy.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains the table of page replacement policies that can be
+// selected with -P and a helper used by the policies to allocate their state.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "perrorExit.h"
+#include "replacementPolicy.h"
+
+// Policies that can be selected by name
+static const ReplacementPolicy * const POLICIES[] = {
+	&FIFO_POLICY,
+	&LRU_POLICY,
+	&CLOCK_POLICY,
+	&CLOCK_PRO_POLICY,
+	&ARC_POLICY,
+	&OPT_POLICY
+};
+
+#define NUM_POLICIES (sizeof(POLICIES) / sizeof(POLICIES[0]))
+
+// Returns the policy with the name or NULL if none exists
+const ReplacementPolicy * getReplacementPolicy(const char * name){
+	unsigned int i;
+
+	for (i = 0; i < NUM_POLICIES; i++)
+		if (strcmp(POLICIES[i]->name, name) == 0)
+			return POLICIES[i];
+
+	return NULL;
+}
+
+// Allocates memory for policy state or exits with an error message
+void * policyAlloc(size_t size){
+	void * ptr;
+
+	if ((ptr = malloc(size)) == NULL)
+		perrorExit("Failed to allocate replacement policy state");
+
+	return ptr;
+}
@@ -0,0 +1,63 @@
+// replacementPolicy.h was created by Mark Renard on 5/10/2020.
+//
+// This file defines the interface oss uses to choose victim frames. Each page
+// replacement policy is a table of hooks called when a frame is allocated to
+// a page, when a process references a page, when a victim frame is needed,
+// and when a terminating process frees a frame. Policies keep whatever state
+// they need in their own source files.
+
+#ifndef REPLACEMENTPOLICY_H
+#define REPLACEMENTPOLICY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "constants.h"
+#include "frameBits.h"
+#include "trace.h"
+
+// Identifies a page by the launch order of its process and its page number
+typedef long PageKey;
+#define pageKey(processNum, pageNum) \
+	((PageKey) (processNum) << 32 | (pageNum))
+#define keyProcess(key) ((int) ((key) >> 32))
+#define keyPage(key) ((int) ((key) & 0xffffffff))
+
+// Key passed to evict when a frame is reclaimed before any fault needs it
+#define RECLAIM_KEY ((PageKey) -2)
+
+typedef struct replacementPolicy {
+	const char * name;	// Name selected with -P
+
+	// Sets up state for a memory with numFrames frames
+	void (*init)(FrameBits * frameBits, int numFrames,
+		     const Trace * trace);
+
+	// Records that the page with the key was loaded into the frame. oss
+	// calls this once the page has been read in, so a frame still being
+	// paged in is never known to the policy or returned by evict
+	void (*allocate)(int frameNum, PageKey key);
+
+	// Records a reference to the page, resident in the frame or EMPTY
+	void (*reference)(int frameNum, PageKey key);
+
+	// Returns a frame to evict to make room for the page with the key
+	int (*evict)(PageKey key);
+
+	// Records that the frame was freed by a terminating process
+	void (*free)(int frameNum);
+
+	bool needsTrace;	// Whether the policy needs a recorded trace
+} ReplacementPolicy;
+
+extern const ReplacementPolicy FIFO_POLICY;
+extern const ReplacementPolicy LRU_POLICY;
+extern const ReplacementPolicy CLOCK_POLICY;
+extern const ReplacementPolicy CLOCK_PRO_POLICY;
+extern const ReplacementPolicy ARC_POLICY;
+extern const ReplacementPolicy OPT_POLICY;
+
+const ReplacementPolicy * getReplacementPolicy(const char * name);
+void * policyAlloc(size_t size);
+
+#endif
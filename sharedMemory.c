@@ -16,15 +16,19 @@
 static int shmid; // The shmid of the shared memory region
 
 // Returns a pointer to a new shared memory region
-char * sharedMemory(int size, int mask){
+char * sharedMemory(size_t size, int mask){
 	shmid = shmget ( SHMKEY, size, 0600 | mask );
 
 	// Prints error message and exits if unsuccessful
 	if (shmid == -1)
 		 perrorExit("sharedMemory call to shmget");
 
-	// Returns pointer to shared memory region
-	return shmat (shmid, 0, 0);
+	// Returns pointer to shared memory region or exits if unsuccessful
+	char * shm = shmat (shmid, 0, 0);
+	if (shm == (char *) -1)
+		perrorExit("sharedMemory call to shmat");
+
+	return shm;
 }
 
 // Detatches the process from shm or exits with error message on failure
@@ -5,10 +5,11 @@
 #ifndef SHAREDMEMORY_H
 #define SHAREDMEMORY_H
 
+#include <stddef.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
-char * sharedMemory(int size, int mask);
+char * sharedMemory(size_t size, int mask);
 void removeSegment();
 void detach(char * shm);
 void initializeSharedMemory(char * shm, int bufferSize, char byte);
@@ -1,21 +1,82 @@
 // stats.c was created by Mark Renard on 5/3/2020.
 //
 // This file defines functions that log statistics related to assignment 6.
+// Each StatCounter has a slot that oss adds to as events happen, and the
+// statistics are computed from the slots once at the end of the run. Access
+// and queue wait times are also recorded in histograms, overall and for each
+// running process, and each process's percentiles are kept when it
+// terminates so that they can be exported with the overall histograms. The
+// buckets of a pcb's histogram are allocated when its first process is
+// launched, so pcbs no process runs in cost no more than the empty histogram.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "stats.h"
 #include "clock.h"
+#include "histogram.h"
+#include "pageTable.h"
+#include "perrorExit.h"
+
+#define NUM_PERCENTILES 4	// Percentiles reported for each distribution
+
+// Access time percentiles of a process that terminated
+typedef struct processSummary {
+	int processNum;				// Order it was launched in
+	uint64_t references;			// References it made
+	Time mean;				// Mean access time
+	Time percentiles[NUM_PERCENTILES];	// Access time percentiles
+	Time max;				// Longest access time
+} ProcessSummary;
+
+// Prototypes
+static void exportJson(FILE * file);
+static void exportCsv(FILE * file);
+static void writeCsvRow(FILE * file, const char * series,
+			const ProcessSummary * summary);
+static void summarize(const Histogram * histogram, int processNum,
+		      ProcessSummary * summary);
 
-static unsigned long int totalMemoryAccesses = 0;
-static unsigned long int totalPageFaults = 0;
-static Clock totalMemoryAccessTime = {0, 0};
+// Constants
+static const double PERCENTILES[NUM_PERCENTILES] = {50, 90, 99, 99.9};
+static const char * HISTOGRAM_NAMES[NUM_STAT_HISTOGRAMS] = {
+	"hit", "fault", "dirty_fault", "queue_wait"
+};
 
-Stats getStats(Clock currentTime){
+// Static global variables
+static Histogram histograms[NUM_STAT_HISTOGRAMS];	// Overall times
+static Histogram * processHistograms = NULL;	// Times of each pcb's process
+static int numProcessHistograms = 0;		// Length of processHistograms
+static ProcessSummary * summaries = NULL;	// Terminated processes
+static int numSummaries = 0;			// Length of summaries
+static int summaryCapacity = 0;			// Capacity of summaries
+
+// Counters packed into one aligned block, so the updates in oss's main loop
+// touch two cache lines and never share one with the log ring's indices
+static uint64_t counters[NUM_STAT_COUNTERS] \
+	__attribute__((aligned(CACHE_LINE_SIZE)));
+
+Stats getStats(Time currentTime){
 	Stats stats;			// Statistics to be returned
 	long double accessSeconds;	// Total memory access time in seconds
 	long double totalSeconds;	// Total execution time in seconds
+	uint64_t totalMemoryAccesses;	// References received
+	uint64_t totalPageFaults;	// References to pages not resident
+	uint64_t totalTlbHits;		// Lookups finding a tlb entry
+	uint64_t totalTlbMisses;	// Lookups finding no tlb entry
+	uint64_t queueWaits;		// Faults that reached the queue front
+	int level;			// Level of the page tables
 
-	accessSeconds = clockSeconds(totalMemoryAccessTime); 
-	totalSeconds = clockSeconds(currentTime);
+	totalMemoryAccesses = counters[STAT_MEMORY_ACCESSES];
+	totalPageFaults = counters[STAT_PAGE_FAULTS];
+	totalTlbHits = counters[STAT_TLB_HITS];
+	totalTlbMisses = counters[STAT_TLB_MISSES];
+	queueWaits = counters[STAT_QUEUE_WAITS];
+
+	accessSeconds = timeToSeconds(counters[STAT_MEMORY_ACCESS_TIME]);
+	totalSeconds = timeToSeconds(currentTime);
 
 	// Computes memory accesses per second
 	stats.memoryAccessesPerSecond = totalMemoryAccesses / totalSeconds;
@@ -27,8 +88,66 @@ Stats getStats(Clock currentTime){
 	// Computes average memory access speed
 	stats.averageMemoryAccessSpeed = accessSeconds / totalMemoryAccesses;
 
+	// Computes tlb hits per lookup, or 0 if there is no tlb
+	stats.tlbHitRate = totalTlbHits + totalTlbMisses == 0 ? 0 \
+			   : (double) totalTlbHits
+			     / (double) (totalTlbHits + totalTlbMisses);
+
+	// Computes average time to translate an address
+	stats.averageTranslationTime = \
+		timeToSeconds(counters[STAT_TRANSLATION_TIME]) \
+		/ totalMemoryAccesses;
+
+	// Computes average time a fault waited for paging to start
+	stats.averageQueueWait = queueWaits == 0 ? 0 \
+		: timeToSeconds(counters[STAT_QUEUE_WAIT_TIME]) / queueWaits;
+
+	// Computes faults serviced per second, the mean number of faults being
+	// paged at once, and the mean number of frames written back at once
+	// ahead of faults
+	stats.faultsServicedPerSecond = counters[STAT_PAGE_INS] / totalSeconds;
+	stats.averageDiskQueueDepth = \
+		timeToSeconds(counters[STAT_DISK_BUSY_TIME]) / totalSeconds;
+	stats.averageBackgroundWrites = \
+		timeToSeconds(counters[STAT_WRITE_BACK_BUSY_TIME])
+		/ totalSeconds;
+
+	// Computes the share of pages read ahead that were used, and the share
+	// of would-be faults they avoided
+	stats.prefetchAccuracy = counters[STAT_PREFETCHES] == 0 ? 0 \
+		: (long double) counters[STAT_PREFETCH_HITS]
+		  / counters[STAT_PREFETCHES];
+	stats.prefetchCoverage = counters[STAT_PREFETCH_HITS] == 0 ? 0 \
+		: (long double) counters[STAT_PREFETCH_HITS]
+		  / (counters[STAT_PREFETCH_HITS] + totalPageFaults);
+
+	// Computes page table entries read per memory access at each level
+	for (level = 0; level < MAX_PAGE_TABLE_DEPTH; level++)
+		stats.pageTableReadsPerMemoryAccess[level] = \
+			(long double) getLevelReads(level) / totalMemoryAccesses;
+
 	fprintf(stderr, "\n\ntotalMemoryAccesses: %lu\n" \
 			"totalPageFaults: %lu\n" \
+			"totalPageHits: %lu\n" \
+			"totalEvictions: %lu\n" \
+			"totalDirtyWriteBacks: %lu\n" \
+			"totalQueueWaits: %lu\n" \
+			"averageQueueWait: %Lf\n" \
+			"totalPageIns: %lu\n" \
+			"faultsServicedPerSecond: %Lf\n" \
+			"averageDiskQueueDepth: %Lf\n" \
+			"averageBackgroundWrites: %Lf\n" \
+			"totalPageouts: %lu\n" \
+			"pageoutSaves: %lu\n" \
+			"wastedPageouts: %lu\n" \
+			"pageoutSavedTime: %Lf\n" \
+			"directReclaims: %lu\n" \
+			"backgroundReclaims: %lu\n" \
+			"totalPrefetches: %lu\n" \
+			"prefetchHits: %lu\n" \
+			"wastedPrefetches: %lu\n" \
+			"prefetchAccuracy: %Lf\n" \
+			"prefetchCoverage: %Lf\n" \
 			"totalMemoryAccessTime: %03d : %09d\n\n" \
 
 			"currentTime: %03d : %09d\n" \
@@ -37,38 +156,288 @@ Stats getStats(Clock currentTime){
 
 			"memoryAccessesPerSecond: %Lf\n" \
 			"pageFaultsPerMemoryAccess: %Lf\n" \
-			"averageMemoryAccessSpeed: %Lf\n\n",
+			"averageMemoryAccessSpeed: %.6Le\n\n" \
+
+			"totalTlbHits: %lu\n" \
+			"totalTlbMisses: %lu\n" \
+			"tlbHitRate: %Lf\n" \
+			"averageTranslationTime: %.3Le\n" \
+			"totalTlbShootdowns: %lu\n" \
+			"totalTlbFlushes: %lu\n\n",
 
 			totalMemoryAccesses,
 			totalPageFaults,
-			totalMemoryAccessTime.seconds,
-			totalMemoryAccessTime.nanoseconds,
+			counters[STAT_PAGE_HITS],
+			counters[STAT_EVICTIONS],
+			counters[STAT_DIRTY_WRITE_BACKS],
+			queueWaits,
+			stats.averageQueueWait,
+			counters[STAT_PAGE_INS],
+			stats.faultsServicedPerSecond,
+			stats.averageDiskQueueDepth,
+			stats.averageBackgroundWrites,
+			counters[STAT_PAGEOUTS],
+			counters[STAT_PAGEOUT_SAVES],
+			counters[STAT_WASTED_PAGEOUTS],
+			timeToSeconds(counters[STAT_PAGEOUT_SAVED_TIME]),
+			counters[STAT_DIRECT_RECLAIMS],
+			counters[STAT_BACKGROUND_RECLAIMS],
+			counters[STAT_PREFETCHES],
+			counters[STAT_PREFETCH_HITS],
+			counters[STAT_WASTED_PREFETCHES],
+			stats.prefetchAccuracy,
+			stats.prefetchCoverage,
+			timeSeconds(counters[STAT_MEMORY_ACCESS_TIME]),
+			timeNanoseconds(counters[STAT_MEMORY_ACCESS_TIME]),
 
-			currentTime.seconds,
-			currentTime.nanoseconds,
+			timeSeconds(currentTime),
+			timeNanoseconds(currentTime),
 			accessSeconds,
 			totalSeconds,
 
 			stats.memoryAccessesPerSecond,
 			stats.pageFaultsPerMemoryAccess,
-			stats.averageMemoryAccessSpeed);
+			stats.averageMemoryAccessSpeed,
+
+			totalTlbHits,
+			totalTlbMisses,
+			stats.tlbHitRate,
+			stats.averageTranslationTime,
+			counters[STAT_TLB_SHOOTDOWNS],
+			counters[STAT_TLB_FLUSHES]);
+
+	// Prints the cost of page table walks at each level and their size
+	for (level = 0; level < getPageTableDepth(); level++)
+		fprintf(stderr, "pageTableLevel%dReadsPerMemoryAccess: %Lf\n" \
+				"pageTableLevel%dWalksEnded: %ld\n",
+				level, stats.pageTableReadsPerMemoryAccess[level],
+				level, getLevelMisses(level));
+
+	fprintf(stderr, "pageTableBytes: %zu\n" \
+			"peakPageTableBytes: %zu\n" \
+			"flatPageTableBytes: %zu\n\n",
+			getPageTableBytes(false),
+			getPageTableBytes(true),
+			getFlatPageTableBytes());
 
 	return stats;
 }
 
-void statsAddMemoryAccessTime(Clock time){
-	incrementClock(&totalMemoryAccessTime, time);
-/*	fprintf(stderr, "totalMemoryAccessTime: %03d : %09d\n",
-		totalMemoryAccessTime.seconds,
-		totalMemoryAccessTime.nanoseconds);
-*/
+// Allocates the overall histograms and an empty histogram for the process of
+// each pcb, whose buckets are allocated when a process is first launched in it
+void initStats(int numPcbs){
+	int i;
+
+	for (i = 0; i < NUM_STAT_HISTOGRAMS; i++)
+		initHistogram(&histograms[i], HISTOGRAM_SUB_BITS);
+
+	processHistograms = calloc(numPcbs, sizeof(Histogram));
+	if (processHistograms == NULL)
+		perrorExit("initStats failed to allocate process histograms");
+	numProcessHistograms = numPcbs;
+}
+
+// Frees the histograms and process summaries
+void freeStats(){
+	int i;
+
+	for (i = 0; i < NUM_STAT_HISTOGRAMS; i++)
+		freeHistogram(&histograms[i]);
+
+	for (i = 0; i < numProcessHistograms; i++)
+		freeHistogram(&processHistograms[i]);
+	free(processHistograms);
+	processHistograms = NULL;
+	numProcessHistograms = 0;
+
+	free(summaries);
+	summaries = NULL;
+	numSummaries = summaryCapacity = 0;
 }
 
-void statsPageFault(){
-	totalPageFaults++;
+// Counts one event
+void statsCount(StatCounter counter){
+	counters[counter]++;
 }
 
-void statsMemoryAccess(){
-	totalMemoryAccesses++;
+// Adds an amount, such as a time in nanoseconds, to a counter
+void statsAdd(StatCounter counter, uint64_t amount){
+	counters[counter] += amount;
 }
 
+// Returns the total of a counter
+uint64_t getStatCount(StatCounter counter){
+	return counters[counter];
+}
+
+// Records the time from a reference to its grant, overall, in the histogram
+// of its kind, and for its process
+void statsAccessTime(int simPid, StatHistogram histogram, Time time){
+	counters[STAT_MEMORY_ACCESS_TIME] += time;
+	recordHistogram(&histograms[histogram], time);
+	recordHistogram(&processHistograms[simPid], time);
+}
+
+// Records the time a fault waited in the queue before paging started
+void statsQueueWait(Time time){
+	counters[STAT_QUEUE_WAITS]++;
+	counters[STAT_QUEUE_WAIT_TIME] += time;
+	recordHistogram(&histograms[HIST_QUEUE_WAIT], time);
+}
+
+// Allocates the buckets of a pcb's histogram when its first process launches
+void statsProcessLaunch(int simPid){
+	if (processHistograms[simPid].counts == NULL)
+		initHistogram(&processHistograms[simPid],
+			      PROCESS_HISTOGRAM_SUB_BITS);
+}
+
+// Keeps the percentiles of a terminated process and empties its histogram
+// for the next process to use its pcb
+void statsProcessTermination(int simPid, int processNum){
+	if (numSummaries == summaryCapacity){
+		summaryCapacity = summaryCapacity == 0 ?
+			INITIAL_PROCESS_SUMMARIES : 2 * summaryCapacity;
+		summaries = realloc(summaries,
+				    sizeof(ProcessSummary) * summaryCapacity);
+		if (summaries == NULL)
+			perrorExit("statsProcessTermination failed to "
+				   "allocate summaries");
+	}
+
+	summarize(&processHistograms[simPid], processNum,
+		  &summaries[numSummaries++]);
+	resetHistogram(&processHistograms[simPid]);
+}
+
+// Returns one of the overall histograms
+const Histogram * getStatHistogram(StatHistogram histogram){
+	return &histograms[histogram];
+}
+
+// Returns the histogram of the process running with a pcb
+const Histogram * getProcessHistogram(int simPid){
+	return &processHistograms[simPid];
+}
+
+// Writes the histograms and process percentiles to a file, as JSON if its
+// name ends in .json and as CSV otherwise
+void exportStats(const char * path){
+	FILE * file;
+	size_t length = strlen(path);
+
+	if ((file = fopen(path, "w")) == NULL)
+		perrorExit("Failed to open statistics export file");
+
+	if (length >= 5 && strcmp(path + length - 5, ".json") == 0)
+		exportJson(file);
+	else
+		exportCsv(file);
+
+	if (fclose(file) != 0)
+		perrorExit("Failed to write statistics export file");
+}
+
+// Writes the percentiles and nonempty buckets of each overall histogram and
+// the percentiles of each terminated process as a JSON object
+static void exportJson(FILE * file){
+	ProcessSummary summary;		// Percentiles of a histogram
+	const Histogram * histogram;	// The histogram being written
+	bool first;			// Whether no bucket was written yet
+	int i, j;
+
+	fprintf(file, "{\n\t\"percentiles\": [");
+	for (j = 0; j < NUM_PERCENTILES; j++)
+		fprintf(file, "%s%g", j == 0 ? "" : ", ", PERCENTILES[j]);
+	fprintf(file, "],\n\t\"histograms\": {");
+
+	for (i = 0; i < NUM_STAT_HISTOGRAMS; i++){
+		histogram = &histograms[i];
+		summarize(histogram, EMPTY, &summary);
+
+		fprintf(file, "%s\n\t\t\"%s\": {\"count\": %lu, "
+			"\"mean_ns\": %lu, \"max_ns\": %lu, "
+			"\"percentiles_ns\": [", i == 0 ? "" : ",",
+			HISTOGRAM_NAMES[i], summary.references, summary.mean,
+			summary.max);
+		for (j = 0; j < NUM_PERCENTILES; j++)
+			fprintf(file, "%s%lu", j == 0 ? "" : ", ",
+				summary.percentiles[j]);
+
+		// Writes [low, high, count] for each bucket holding values
+		fprintf(file, "],\n\t\t\t\"buckets\": [");
+		first = true;
+		for (j = 0; j < histogram->numBuckets; j++){
+			if (histogram->counts[j] == 0) continue;
+			fprintf(file, "%s[%lu, %lu, %lu]", first ? "" : ", ",
+				bucketLow(histogram, j),
+				bucketHigh(histogram, j),
+				histogram->counts[j]);
+			first = false;
+		}
+		fprintf(file, "]}");
+	}
+
+	fprintf(file, "\n\t},\n\t\"processes\": [");
+	for (i = 0; i < numSummaries; i++){
+		fprintf(file, "%s\n\t\t{\"process\": %d, \"count\": %lu, "
+			"\"mean_ns\": %lu, \"max_ns\": %lu, "
+			"\"percentiles_ns\": [", i == 0 ? "" : ",",
+			summaries[i].processNum, summaries[i].references,
+			summaries[i].mean, summaries[i].max);
+		for (j = 0; j < NUM_PERCENTILES; j++)
+			fprintf(file, "%s%lu", j == 0 ? "" : ", ",
+				summaries[i].percentiles[j]);
+		fprintf(file, "]}");
+	}
+	fprintf(file, "\n\t]\n}\n");
+}
+
+// Writes a row of percentiles for each overall histogram and each
+// terminated process
+static void exportCsv(FILE * file){
+	ProcessSummary summary;	// Percentiles of an overall histogram
+	char series[BUFF_SZ];	// Name of a process's row
+	int i, j;
+
+	fprintf(file, "series,count,mean_ns,max_ns");
+	for (j = 0; j < NUM_PERCENTILES; j++)
+		fprintf(file, ",p%g_ns", PERCENTILES[j]);
+	fprintf(file, "\n");
+
+	for (i = 0; i < NUM_STAT_HISTOGRAMS; i++){
+		summarize(&histograms[i], EMPTY, &summary);
+		writeCsvRow(file, HISTOGRAM_NAMES[i], &summary);
+	}
+
+	for (i = 0; i < numSummaries; i++){
+		snprintf(series, BUFF_SZ, "P%d", summaries[i].processNum);
+		writeCsvRow(file, series, &summaries[i]);
+	}
+}
+
+// Writes one row of percentiles
+static void writeCsvRow(FILE * file, const char * series,
+			const ProcessSummary * summary){
+	int j;
+
+	fprintf(file, "%s,%lu,%lu,%lu", series, summary->references,
+		summary->mean, summary->max);
+	for (j = 0; j < NUM_PERCENTILES; j++)
+		fprintf(file, ",%lu", summary->percentiles[j]);
+	fprintf(file, "\n");
+}
+
+// Fills a summary with the count, mean, percentiles, and max of a histogram
+static void summarize(const Histogram * histogram, int processNum,
+		      ProcessSummary * summary){
+	int j;
+
+	summary->processNum = processNum;
+	summary->references = histogram->total;
+	summary->mean = histogramMean(histogram);
+	summary->max = histogram->max;
+	for (j = 0; j < NUM_PERCENTILES; j++)
+		summary->percentiles[j] = histogramPercentile(histogram,
+							      PERCENTILES[j]);
+}
@@ -2,22 +2,87 @@
 //
 // This file contains the definition of a struct with collected statistics on
 // the execution of oss in assignment 5, along with functions for collecting them.
+// oss counts events directly from its paging paths, so the statistics stay
+// complete when the log stops at MAX_LOG_LINES.
 
 #ifndef STATS_H
 #define STATS_H
 
 #include "clock.h"
+#include "constants.h"
+#include "histogram.h"
+
+// Counters oss updates from its paging paths, each with a slot in stats.c
+typedef enum statCounter {
+	STAT_MEMORY_ACCESSES,		// References received
+	STAT_PAGE_HITS,			// References to resident pages
+	STAT_PAGE_FAULTS,		// References to pages not resident
+	STAT_EVICTIONS,			// Victim frames taken from a page
+	STAT_DIRTY_WRITE_BACKS,		// Victim frames written to disk
+	STAT_QUEUE_WAITS,		// Faults that reached the queue front
+	STAT_PAGE_INS,			// Faults whose page read completed
+	STAT_PAGEOUTS,			// Dirty frames the daemon cleaned
+	STAT_PAGEOUT_SAVES,		// Victims clean thanks to the daemon
+	STAT_WASTED_PAGEOUTS,		// Cleaned frames dirtied or freed
+	STAT_DIRECT_RECLAIMS,		// Victims evicted by faults
+	STAT_BACKGROUND_RECLAIMS,	// Victims evicted into the free pool
+	STAT_PREFETCHES,		// Pages read ahead of faults
+	STAT_PREFETCH_HITS,		// Pages read ahead then referenced
+	STAT_WASTED_PREFETCHES,		// Pages read ahead but never used
+	STAT_TLB_HITS,			// Lookups finding a tlb entry
+	STAT_TLB_MISSES,		// Lookups finding no tlb entry
+	STAT_TLB_SHOOTDOWNS,		// Tlb entries invalidated
+	STAT_TLB_FLUSHES,		// Flushes of the whole tlb
+	STAT_MEMORY_ACCESS_TIME,	// Ns from requests to their grants
+	STAT_TRANSLATION_TIME,		// Ns spent translating addresses
+	STAT_QUEUE_WAIT_TIME,		// Ns faults waited to start paging
+	STAT_DISK_BUSY_TIME,		// Ns disk channels spent paging faults
+	STAT_WRITE_BACK_BUSY_TIME,	// Ns disk channels spent writing back
+					// frames for the pageout daemon or
+					// the reclaimer
+	STAT_PAGEOUT_SAVED_TIME,	// Ns of write-backs taken off faults
+	NUM_STAT_COUNTERS
+} StatCounter;
+
+// Distributions of times oss records, each in a histogram in stats.c
+typedef enum statHistogram {
+	HIST_HIT_ACCESS,		// Access times of resident pages
+	HIST_FAULT_ACCESS,		// Access times of faults, clean victim
+	HIST_DIRTY_FAULT_ACCESS,	// Access times of faults, dirty victim
+	HIST_QUEUE_WAIT,		// Ns faults waited to start paging
+	NUM_STAT_HISTOGRAMS
+} StatHistogram;
 
 typedef struct stats {
 	long double memoryAccessesPerSecond;
 	long double pageFaultsPerMemoryAccess;
 	long double averageMemoryAccessSpeed;
+	long double tlbHitRate;
+	long double averageTranslationTime;
+	long double averageQueueWait;
+	long double faultsServicedPerSecond;
+	long double averageDiskQueueDepth;
+	long double averageBackgroundWrites;
+	long double prefetchAccuracy;
+	long double prefetchCoverage;
+
+	// Page table entries read per memory access at each level
+	long double pageTableReadsPerMemoryAccess[MAX_PAGE_TABLE_DEPTH];
 } Stats;
 
-Stats getStats(Clock currentTime);
-void statsAddMemoryAccessTime(Clock time);
-void statsPageFault();
-void statsMemoryAccess();
+Stats getStats(Time currentTime);
+void initStats(int numPcbs);
+void freeStats();
+void statsCount(StatCounter counter);
+void statsAdd(StatCounter counter, uint64_t amount);
+uint64_t getStatCount(StatCounter counter);
+void statsAccessTime(int simPid, StatHistogram histogram, Time time);
+void statsQueueWait(Time time);
+void statsProcessLaunch(int simPid);
+void statsProcessTermination(int simPid, int processNum);
+const Histogram * getStatHistogram(StatHistogram histogram);
+const Histogram * getProcessHistogram(int simPid);
+void exportStats(const char * path);
 
 
 #endif
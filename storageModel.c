@@ -0,0 +1,51 @@
+// storageModel.c was created by Mark Renard on 5/12/2020.
+//
+// This file contains the table of storage models that can be selected with
+// -D and the flat model, which takes the same time for every transfer.
+
+#include <string.h>
+
+#include "constants.h"
+#include "storageModel.h"
+
+// Prototypes
+static void flatInit(long numSlots, Time ioTime);
+static Time flatTransfer(long slot, bool write, Time now);
+
+const StorageModel FLAT_STORAGE = {
+	"flat", DISK_CHANNELS, flatInit, flatTransfer
+};
+
+// Models that can be selected by name
+static const StorageModel * const MODELS[] = {
+	&FLAT_STORAGE,
+	&HDD_STORAGE,
+	&SSD_STORAGE,
+	&NVME_STORAGE
+};
+
+#define NUM_MODELS (sizeof(MODELS) / sizeof(MODELS[0]))
+
+// Static global variables
+static Time flatTime;	// Time of every transfer
+
+// Returns the model with the name or NULL if none exists
+const StorageModel * getStorageModel(const char * name){
+	unsigned int i;
+
+	for (i = 0; i < NUM_MODELS; i++)
+		if (strcmp(MODELS[i]->name, name) == 0)
+			return MODELS[i];
+
+	return NULL;
+}
+
+// Takes ioTime for every transfer
+static void flatInit(long numSlots, Time ioTime){
+	flatTime = ioTime;
+}
+
+// Returns the same time for every slot, read or write
+static Time flatTransfer(long slot, bool write, Time now){
+	return flatTime;
+}
@@ -0,0 +1,36 @@
+// storageModel.h was created by Mark Renard on 5/12/2020.
+//
+// This file defines the interface the disk uses to time paging transfers.
+// Each model of backing store is a table of hooks called to set it up and to
+// time each page read from or written to a swap slot, and keeps whatever
+// state it needs, such as the position of a disk head or when each flash unit
+// is next free, in its own source file.
+
+#ifndef STORAGEMODEL_H
+#define STORAGEMODEL_H
+
+#include <stdbool.h>
+
+#include "clock.h"
+
+typedef struct storageModel {
+	const char * name;	// Name selected with -D
+	int queueDepth;		// Default number of disk channels
+
+	// Sets up state for a device of numSlots swap slots, where ioTime is
+	// the time -i gives to each transfer
+	void (*init)(long numSlots, Time ioTime);
+
+	// Returns the time from now until a page is read from or written to
+	// the slot, including any wait for the device to finish earlier ones
+	Time (*transfer)(long slot, bool write, Time now);
+} StorageModel;
+
+extern const StorageModel FLAT_STORAGE;
+extern const StorageModel HDD_STORAGE;
+extern const StorageModel SSD_STORAGE;
+extern const StorageModel NVME_STORAGE;
+
+const StorageModel * getStorageModel(const char * name);
+
+#endif
@@ -0,0 +1,156 @@
+// tlb.c was created by Mark Renard on 5/11/2020.
+//
+// This file contains a set associative translation lookaside buffer. A page
+// maps to a set chosen by hashing its simPid with its page number, so that
+// the low pages every process uses most do not all compete for one set, and
+// within a set the least recently used entry or a random entry is replaced.
+// Random choices come from a generator of the buffer's own so that they do
+// not change the references made by processes seeded with -s.
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+#include "stats.h"
+#include "tlb.h"
+
+typedef struct tlbEntry {
+	int simPid;		// Process of the page or EMPTY if unused
+	int pageNum;		// Page number
+	int frameNum;		// Frame holding the page
+	unsigned long lastUse;	// Lookup count when the entry was last used
+} TlbEntry;
+
+// Prototypes
+static TlbEntry * findEntry(int simPid, int pageNum);
+static TlbEntry * getSet(int simPid, int pageNum);
+static void flush();
+static unsigned int nextRandom();
+
+// Static global variables
+static TlbEntry * entries = NULL;	// Entries grouped by set, or NULL
+static int numSets;			// Number of sets
+static int setSize;			// Entries per set
+static bool flushing;			// Whether switches flush every entry
+static bool randomVictims;		// Whether victims are chosen at random
+static int currentPid = EMPTY;		// Process of the last reference
+static unsigned long uses = 0;		// Lookups and inserts so far
+static unsigned int randomState = TLB_SEED;	// State of nextRandom
+
+// Allocates an empty buffer of numEntries entries in sets of ways entries
+void initTlb(int numEntries, int ways, bool flushOnSwitch,
+	     bool randomReplacement){
+	int i;
+
+	numSets = numEntries / ways;
+	setSize = ways;
+	flushing = flushOnSwitch;
+	randomVictims = randomReplacement;
+
+	if ((entries = malloc(sizeof(TlbEntry) * numEntries)) == NULL)
+		perrorExit("Failed to allocate tlb");
+
+	for (i = 0; i < numEntries; i++)
+		entries[i].simPid = EMPTY;
+}
+
+// Flushes the buffer if the process differs from the last and flushes are on
+void tlbSwitchTo(int simPid){
+	if (entries == NULL || simPid == currentPid) return;
+
+	if (flushing && currentPid != EMPTY){
+		flush();
+		statsCount(STAT_TLB_FLUSHES);
+	}
+	currentPid = simPid;
+}
+
+// Returns the frame cached for the page, or EMPTY on a miss
+int tlbLookup(int simPid, int pageNum){
+	TlbEntry * entry;
+
+	if (entries == NULL) return EMPTY;
+
+	if ((entry = findEntry(simPid, pageNum)) == NULL){
+		statsCount(STAT_TLB_MISSES);
+		return EMPTY;
+	}
+
+	statsCount(STAT_TLB_HITS);
+	entry->lastUse = ++uses;
+	return entry->frameNum;
+}
+
+// Caches the frame of a page, replacing an unused or victim entry of its set
+void tlbInsert(int simPid, int pageNum, int frameNum){
+	TlbEntry * set;		// Entries the page can be cached in
+	TlbEntry * victim;	// Entry replaced
+	int i;
+
+	if (entries == NULL || findEntry(simPid, pageNum) != NULL) return;
+
+	set = getSet(simPid, pageNum);
+
+	// Uses an unused entry, or else the least recently used or a random one
+	victim = &set[0];
+	for (i = 0; i < setSize && victim->simPid != EMPTY; i++){
+		if (set[i].simPid == EMPTY || set[i].lastUse < victim->lastUse)
+			victim = &set[i];
+	}
+	if (randomVictims && victim->simPid != EMPTY)
+		victim = &set[nextRandom() % setSize];
+
+	victim->simPid = simPid;
+	victim->pageNum = pageNum;
+	victim->frameNum = frameNum;
+	victim->lastUse = ++uses;
+}
+
+// Invalidates the entry of a page that was swapped out or freed
+void tlbShootdown(int simPid, int pageNum){
+	TlbEntry * entry;
+
+	if (entries == NULL) return;
+
+	if ((entry = findEntry(simPid, pageNum)) != NULL){
+		entry->simPid = EMPTY;
+		statsCount(STAT_TLB_SHOOTDOWNS);
+	}
+}
+
+// Returns the entry caching a page or NULL if it is not cached
+static TlbEntry * findEntry(int simPid, int pageNum){
+	TlbEntry * set = getSet(simPid, pageNum);
+	int i;
+
+	for (i = 0; i < setSize; i++)
+		if (set[i].simPid == simPid && set[i].pageNum == pageNum)
+			return &set[i];
+
+	return NULL;
+}
+
+// Returns the first entry of the set a process's page maps to
+static TlbEntry * getSet(int simPid, int pageNum){
+	unsigned int hash = (unsigned int) simPid * TLB_HASH_MULTIPLIER
+			    + (unsigned int) pageNum;
+
+	return &entries[(long) (hash % numSets) * setSize];
+}
+
+// Invalidates every entry
+static void flush(){
+	int i;
+
+	for (i = 0; i < numSets * setSize; i++)
+		entries[i].simPid = EMPTY;
+}
+
+// Returns the next value of a xorshift generator
+static unsigned int nextRandom(){
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
@@ -0,0 +1,20 @@
+// tlb.h was created by Mark Renard on 5/11/2020.
+//
+// This file defines the interface to a simulated translation lookaside buffer
+// caching the frames of recently referenced pages in front of the page
+// tables. Entries are tagged with the simPid of their process, or the whole
+// buffer is flushed whenever oss handles a reference from another process.
+
+#ifndef TLB_H
+#define TLB_H
+
+#include <stdbool.h>
+
+void initTlb(int numEntries, int ways, bool flushOnSwitch,
+	     bool randomReplacement);
+void tlbSwitchTo(int simPid);
+int tlbLookup(int simPid, int pageNum);
+void tlbInsert(int simPid, int pageNum, int frameNum);
+void tlbShootdown(int simPid, int pageNum);
+
+#endif
@@ -0,0 +1,362 @@
+// trace.c was created by Mark Renard on 5/10/2020.
+//
+// This file contains functions that record each memory reference oss
+// processes to a trace file and load such a file so that its references can
+// be replayed one process at a time. The header is eight bytes of magic and
+// the page size the addresses were made with, as four bytes least
+// significant first, and a trace is only replayed with that page size. Each
+// record after it is three varints: the zigzag encoded change in process
+// number shifted left past a bit holding the reference type, the zigzag
+// encoded change in address from the same process's last reference, and the
+// simulated nanoseconds since the last record. Records are written through a
+// buffer and read back from a mapping of the whole file.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+#include "trace.h"
+
+// State of the trace being recorded or decoded
+typedef struct traceCoder {
+	unsigned int processNum;	// Process of the last record
+	int * addresses;		// Last address of each process
+	unsigned int numAddresses;	// Capacity of addresses
+	Time time;			// Simulated time of the last record
+} TraceCoder;
+
+// Prototypes
+static void * traceAlloc(size_t size);
+static void initCoder(TraceCoder * coder);
+static int * lastAddress(TraceCoder * coder, unsigned int processNum);
+static void writeVarint(unsigned long value);
+static const unsigned char * readVarint(const unsigned char * pos,
+					const unsigned char * end,
+					unsigned long * value);
+static unsigned long zigzag(long value);
+static long unzigzag(unsigned long value);
+static void flushTraceBuffer();
+static void indexTrace(Trace * trace);
+
+// Static global variables
+static FILE * traceFile = NULL;			// File references are recorded in
+static unsigned char buffer[TRACE_BUFFER_SIZE];	// Records not yet written
+static size_t buffered = 0;			// Bytes in buffer
+static TraceCoder encoder;			// State of the recording
+
+// Opens the file references are recorded in and writes its header, which
+// holds the size of the pages the recorded addresses are in
+void openTraceFile(const char * path, int pageSize){
+	unsigned char header[TRACE_HEADER_SIZE];
+	int i;
+
+	if ((traceFile = fopen(path, "w")) == NULL)
+		perrorExit("Failed to open trace file for writing");
+
+	memcpy(header, TRACE_MAGIC, TRACE_MAGIC_SIZE);
+	for (i = TRACE_MAGIC_SIZE; i < TRACE_HEADER_SIZE; i++){
+		header[i] = pageSize & 0xff;
+		pageSize >>= 8;
+	}
+
+	if (fwrite(header, 1, TRACE_HEADER_SIZE, traceFile)
+	    != TRACE_HEADER_SIZE)
+		perrorExit("Failed to write trace header");
+
+	initCoder(&encoder);
+}
+
+// Records a reference if a trace file is open
+void traceReference(unsigned int processNum, int address, RefType type,
+		    Time time){
+	int * last;
+
+	if (traceFile == NULL) return;
+
+	// Makes room for a record of the longest varints
+	if (buffered + TRACE_MAX_RECORD_SIZE > TRACE_BUFFER_SIZE)
+		flushTraceBuffer();
+
+	last = lastAddress(&encoder, processNum);
+	writeVarint(zigzag((long) processNum - encoder.processNum) << 1 | type);
+	writeVarint(zigzag((long) address - *last));
+	writeVarint(time - encoder.time);
+
+	encoder.processNum = processNum;
+	*last = address;
+	encoder.time = time;
+}
+
+// Writes buffered records and closes the trace file if one is open
+void closeTraceFile(){
+	if (traceFile == NULL) return;
+
+	flushTraceBuffer();
+	if (fclose(traceFile) != 0)
+		perrorExit("Failed to close trace file");
+	traceFile = NULL;
+	free(encoder.addresses);
+}
+
+// Maps a trace file, decodes its records, and indexes them by process and by
+// pages of pageSize bytes, exiting if the trace was made with another size
+void loadTrace(Trace * trace, const char * path, int pageSize){
+	FILE * file;			// The trace file
+	struct stat status;		// Status of the trace file, including size
+	const unsigned char * map;	// Mapping of the whole file
+	const unsigned char * pos;	// Next byte to decode
+	const unsigned char * end;	// End of the mapping
+	TraceCoder decoder;		// State of the decoding
+	unsigned long fields[3];	// Varints of a record
+	long processNum;		// Process number of the record
+	TraceRecord * record;		// Record being decoded
+	int * last;			// Last address of the record's process
+	long tracePageSize;		// Page size in the header
+	long i;
+
+	if ((file = fopen(path, "r")) == NULL)
+		perrorExit("Failed to open trace file for reading");
+
+	if (fstat(fileno(file), &status) == -1)
+		perrorExit("Failed to get size of trace file");
+
+	if (status.st_size < TRACE_HEADER_SIZE)
+		perrorExit("Trace file has no header");
+
+	map = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE,
+		   fileno(file), 0);
+	if (map == MAP_FAILED)
+		perrorExit("Failed to map trace file");
+	madvise((void *) map, status.st_size, MADV_SEQUENTIAL);
+	fclose(file);
+
+	if (memcmp(map, TRACE_MAGIC, TRACE_MAGIC_SIZE) != 0)
+		perrorExit("Trace file has an unknown format");
+
+	// Rejects traces whose addresses are in pages of another size
+	tracePageSize = 0;
+	for (i = TRACE_HEADER_SIZE - 1; i >= TRACE_MAGIC_SIZE; i--)
+		tracePageSize = tracePageSize << 8 | map[i];
+	if (tracePageSize != pageSize)
+		perrorExit("Trace was made with a page size other than -z");
+	end = map + status.st_size;
+
+	// Counts records, since each ends three varints ending below 0x80
+	trace->length = 0;
+	for (pos = map + TRACE_HEADER_SIZE; pos < end; pos++)
+		trace->length += *pos < 0x80;
+	trace->length /= 3;
+	trace->pageSize = pageSize;
+
+	// Decodes the records
+	trace->records = traceAlloc(sizeof(TraceRecord) * (trace->length + 1));
+	initCoder(&decoder);
+	pos = map + TRACE_HEADER_SIZE;
+	for (i = 0; i < trace->length; i++){
+		pos = readVarint(pos, end, &fields[0]);
+		pos = readVarint(pos, end, &fields[1]);
+		pos = readVarint(pos, end, &fields[2]);
+
+		// Rejects process numbers too large to index the trace by
+		processNum = (long) decoder.processNum
+			     + unzigzag(fields[0] >> 1);
+		if (processNum < 0 || processNum >= MAX_TRACE_PROCESSES)
+			perrorExit("Trace contains an illegal process number");
+
+		record = &trace->records[i];
+		record->processNum = processNum;
+		record->type = fields[0] & 1;
+
+		last = lastAddress(&decoder, record->processNum);
+		record->address = *last + unzigzag(fields[1]);
+
+		decoder.processNum = record->processNum;
+		*last = record->address;
+	}
+	if (pos != end)
+		perrorExit("Trace file is truncated");
+
+	munmap((void *) map, status.st_size);
+	free(decoder.addresses);
+
+	indexTrace(trace);
+}
+
+// Frees the memory holding a loaded trace
+void freeTrace(Trace * trace){
+	free(trace->records);
+	free(trace->processStart);
+	free(trace->positions);
+	free(trace->replayed);
+	free(trace->lengthRegisters);
+}
+
+// Returns true if the process has references left to replay
+bool traceProcessContinues(const Trace * trace, int processNum){
+	return trace->replayed[processNum] < trace->processStart[processNum + 1]
+					     - trace->processStart[processNum];
+}
+
+// Gets the process's next reference and returns its index in the trace
+long nextTraceReference(Trace * trace, int processNum, int * address,
+			RefType * type){
+	long index;	// Index of the reference in the trace
+
+	index = trace->positions[trace->processStart[processNum]
+				 + trace->replayed[processNum]++];
+
+	*address = trace->records[index].address;
+	*type = trace->records[index].type;
+
+	return index;
+}
+
+// Groups record indices by process and finds each process's page count
+static void indexTrace(Trace * trace){
+	TraceRecord * record;	// The record being indexed
+	long * next;		// Next free position of each process
+	int pageNum;		// Page number of the record's address
+	long i;
+
+	// Counts processes
+	trace->numProcesses = 0;
+	trace->maxLengthRegister = MIN_ALLOC_PAGES;
+	for (i = 0; i < trace->length; i++){
+		record = &trace->records[i];
+		if (record->processNum >= (unsigned int) trace->numProcesses)
+			trace->numProcesses = record->processNum + 1;
+	}
+
+	trace->processStart = traceAlloc(sizeof(long)
+					 * (trace->numProcesses + 1));
+	trace->positions = traceAlloc(sizeof(long) * (trace->length + 1));
+	trace->replayed = traceAlloc(sizeof(long) * (trace->numProcesses + 1));
+	trace->lengthRegisters = traceAlloc(sizeof(int)
+					    * (trace->numProcesses + 1));
+	next = traceAlloc(sizeof(long) * (trace->numProcesses + 1));
+
+	for (i = 0; i <= trace->numProcesses; i++){
+		trace->processStart[i] = 0;
+		trace->replayed[i] = 0;
+		trace->lengthRegisters[i] = MIN_ALLOC_PAGES;
+	}
+
+	// Counts references and pages of each process
+	for (i = 0; i < trace->length; i++){
+		record = &trace->records[i];
+		pageNum = record->address / trace->pageSize;
+
+		if (record->address < 0 || pageNum >= MAX_PAGES)
+			perrorExit("Trace contains an illegal address");
+
+		trace->processStart[record->processNum + 1]++;
+		if (pageNum >= trace->lengthRegisters[record->processNum])
+			trace->lengthRegisters[record->processNum] = pageNum + 1;
+		if (pageNum >= trace->maxLengthRegister)
+			trace->maxLengthRegister = pageNum + 1;
+	}
+
+	// Converts counts to the index of each process's first position
+	for (i = 0; i < trace->numProcesses; i++){
+		trace->processStart[i + 1] += trace->processStart[i];
+		next[i] = trace->processStart[i];
+	}
+
+	// Stores the index of each record in its process's positions
+	for (i = 0; i < trace->length; i++)
+		trace->positions[next[trace->records[i].processNum]++] = i;
+
+	free(next);
+}
+
+// Starts coding at process 0, time 0, and address 0 for every process
+static void initCoder(TraceCoder * coder){
+	coder->processNum = 0;
+	coder->addresses = NULL;
+	coder->numAddresses = 0;
+	coder->time = 0;
+}
+
+// Returns the last address of a process, growing the array of addresses
+static int * lastAddress(TraceCoder * coder, unsigned int processNum){
+	unsigned int capacity = coder->numAddresses;
+
+	if (processNum >= capacity){
+		while (processNum >= capacity)
+			capacity = capacity == 0 ? INITIAL_TRACE_PROCESSES
+						 : 2 * capacity;
+
+		coder->addresses = realloc(coder->addresses,
+					   sizeof(int) * capacity);
+		if (coder->addresses == NULL)
+			perrorExit("Failed to allocate trace addresses");
+
+		memset(coder->addresses + coder->numAddresses, 0,
+		       sizeof(int) * (capacity - coder->numAddresses));
+		coder->numAddresses = capacity;
+	}
+
+	return &coder->addresses[processNum];
+}
+
+// Appends a varint to the buffer, seven bits at a time from the lowest
+static void writeVarint(unsigned long value){
+	while (value >= 0x80){
+		buffer[buffered++] = value | 0x80;
+		value >>= 7;
+	}
+	buffer[buffered++] = value;
+}
+
+// Decodes the varint at pos, returning the position after it, or exits if
+// the trace ends in the middle of it or it is longer than a 64 bit varint
+static const unsigned char * readVarint(const unsigned char * pos,
+					const unsigned char * end,
+					unsigned long * value){
+	int shift = 0;
+
+	*value = 0;
+	while (pos < end && *pos >= 0x80){
+		*value |= (unsigned long) (*pos++ & 0x7f) << shift;
+		shift += 7;
+		if (shift >= MAX_VARINT_BYTES * 7)
+			perrorExit("Trace file has a malformed varint");
+	}
+	if (pos == end)
+		perrorExit("Trace file is truncated");
+
+	*value |= (unsigned long) *pos++ << shift;
+	return pos;
+}
+
+// Maps small negative and positive numbers to small unsigned numbers
+static unsigned long zigzag(long value){
+	return ((unsigned long) value << 1) ^ (unsigned long) (value >> 63);
+}
+
+// Reverses zigzag
+static long unzigzag(unsigned long value){
+	return (long) (value >> 1) ^ -(long) (value & 1);
+}
+
+// Writes the buffered records to the trace file
+static void flushTraceBuffer(){
+	if (fwrite(buffer, 1, buffered, traceFile) != buffered)
+		perrorExit("Failed to write trace records");
+	buffered = 0;
+}
+
+// Allocates memory for a trace or exits with an error message
+static void * traceAlloc(size_t size){
+	void * ptr;
+
+	if ((ptr = malloc(size)) == NULL)
+		perrorExit("Failed to allocate memory for trace");
+
+	return ptr;
+}
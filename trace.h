@@ -0,0 +1,48 @@
+// trace.h was created by Mark Renard on 5/10/2020.
+//
+// This file defines a recorded trace of the memory references oss processed,
+// in the order it processed them, which can be replayed by processes
+// simulated in oss and which gives the optimal policy its future references.
+// Trace files are compact, but loaded traces are decoded into fixed-width
+// records so that each process's references can be found directly.
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+
+#include "clock.h"
+#include "pcb.h"
+
+// One reference decoded from a trace file
+typedef struct traceRecord {
+	unsigned int processNum;	// Launch order of the process
+	int address;			// Referenced virtual address
+	unsigned int type;		// RefType of the reference
+} TraceRecord;
+
+// A trace file loaded into memory and indexed by process
+typedef struct trace {
+	TraceRecord * records;	// Every reference in the order processed
+	long length;		// Number of records
+	int numProcesses;	// Number of processes that made references
+	int pageSize;		// Bytes in a page of the replayed addresses
+
+	long * processStart;	// Index in positions of each process's first
+	long * positions;	// Indices of records grouped by process
+	long * replayed;	// References replayed so far by each process
+	int * lengthRegisters;	// Pages each process referenced
+	int maxLengthRegister;	// Most pages referenced by any process
+} Trace;
+
+void openTraceFile(const char * path, int pageSize);
+void traceReference(unsigned int processNum, int address, RefType type,
+		    Time time);
+void closeTraceFile();
+void loadTrace(Trace * trace, const char * path, int pageSize);
+void freeTrace(Trace * trace);
+bool traceProcessContinues(const Trace * trace, int processNum);
+long nextTraceReference(Trace * trace, int processNum, int * address,
+			RefType * type);
+
+#endif
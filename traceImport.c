@@ -0,0 +1,462 @@
+// traceImport.c was created by Mark Renard on 5/11/2020.
+//
+// This program converts address traces made by other tools into trace files
+// that oss can replay with -p -T. It reads the output of Valgrind's lackey
+// tool run with --trace-mem=yes, or lines of R or W followed by a hexadecimal
+// address, and each input file becomes one process. Files compressed with
+// gzip are read directly when the program is built with zlib. The pages of
+// each process are numbered in the order they are first referenced, so that a
+// sparse 64 bit address space becomes a dense one of pages of the size given
+// with -z, which the trace records so that oss replays it with the same size.
+// Input is read through a fixed buffer, so memory grows only with the number of
+// distinct pages referenced.
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+
+#include "clock.h"
+#include "constants.h"
+#include "perrorExit.h"
+#include "trace.h"
+
+// An input file and the page numbers of the process it becomes
+typedef struct importSource {
+#ifdef ZLIB
+	gzFile file;			// The input file
+#else
+	int file;			// Descriptor of the input file
+#endif
+	char * buffer;			// Bytes read but not yet parsed
+	char * pos;			// Start of the next line in buffer
+	char * end;			// End of the bytes read into buffer
+	bool atEof;			// Whether the file has been read to the end
+	bool done;			// Whether every reference has been imported
+	unsigned long * keys;		// Virtual page + 1 in each slot, or 0
+	int * pageNums;			// Page number given to the page in a slot
+	int slotBits;			// Log base 2 of the number of slots
+	int numPages;			// Pages numbered so far
+	long references;		// References imported
+	long skipped;			// Lines that were not references
+	long bytes;			// Bytes parsed
+} ImportSource;
+
+// Prototypes
+static void getImportOptions(int argc, char * argv[]);
+static void printUsageExit();
+static void openSource(ImportSource * src, const char * path);
+static void closeSource(ImportSource * src);
+static bool nextReference(ImportSource * src, unsigned long * address,
+			  RefType * type);
+static char * nextLine(ImportSource * src, char ** lineEnd);
+static void refill(ImportSource * src);
+static bool parseLine(ImportSource * src, const char * pos, const char * end,
+		      unsigned long * address, RefType * type);
+static int mapAddress(ImportSource * src, unsigned long address);
+static void allocSlots(ImportSource * src, int slotBits);
+static void growSlots(ImportSource * src);
+static void initHexValues();
+static void * importAlloc(size_t size);
+
+// Constants
+static const Time REFERENCE_INTERVAL = IMPORT_REFERENCE_NS;
+
+// Static global variables
+static char * outputPath = NULL;	// File the trace is written to
+static bool dataOnly = false;		// Whether instruction fetches are skipped
+static int quantum = IMPORT_QUANTUM;	// References taken from a file in turn
+static long maxReferences = -1;		// References imported at most, or -1
+static int pageSize = PAGE_SIZE;	// Bytes in a page of the trace
+static int maxPages = MAX_PAGES;	// Pages each process may number
+static signed char hexValues[256];	// Value of each hex digit or -1
+
+int main(int argc, char * argv[]){
+	ImportSource * sources;	// One source for each input file
+	int numSources;		// Number of input files
+	int live;		// Sources with references left
+	unsigned long address;	// Address of the reference being imported
+	RefType type;		// Type of the reference being imported
+	Time now = 0;		// Time recorded for the reference
+	long imported = 0;	// References imported from every source
+	long bytes = 0;		// Bytes parsed from every source
+	struct timespec start, stop;
+	double seconds;
+	int i, j;
+
+	exeName = argv[0];	// Assigns exeName for perrorExit
+	signalGroup = false;	// Exits alone on errors, outside oss
+
+	getImportOptions(argc, argv);
+	initHexValues();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	numSources = argc - optind;
+	sources = importAlloc(sizeof(ImportSource) * numSources);
+	for (i = 0; i < numSources; i++)
+		openSource(&sources[i], argv[optind + i]);
+
+	openTraceFile(outputPath, pageSize);
+
+	// Takes quantum references from each file in turn
+	live = numSources;
+	while (live > 0 && imported != maxReferences){
+		for (i = 0; i < numSources && imported != maxReferences; i++){
+			if (sources[i].done) continue;
+
+			for (j = 0; j < quantum && imported != maxReferences;
+			     j++){
+				if (!nextReference(&sources[i], &address,
+						   &type)){
+					closeSource(&sources[i]);
+					live--;
+					break;
+				}
+
+				traceReference(i, mapAddress(&sources[i],
+							     address),
+					       type, now);
+				now += REFERENCE_INTERVAL;
+				imported++;
+			}
+		}
+	}
+
+	closeTraceFile();
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	seconds = (stop.tv_sec - start.tv_sec)
+		  + (stop.tv_nsec - start.tv_nsec) / 1e9;
+
+	for (i = 0; i < numSources; i++){
+		fprintf(stderr, "process %d: %s: %ld references, %d pages, "
+			"%ld lines skipped\n", i, argv[optind + i],
+			sources[i].references, sources[i].numPages,
+			sources[i].skipped);
+		bytes += sources[i].bytes;
+		if (!sources[i].done) closeSource(&sources[i]);
+	}
+	fprintf(stderr, "imported %ld references in %.3fs: %.1f MB/s, "
+		"%.1f million references/s\n", imported, seconds,
+		bytes / seconds / MILLION, imported / seconds / MILLION);
+
+	free(sources);
+	return 0;
+}
+
+// Sets the options from the command line or exits with a usage message
+static void getImportOptions(int argc, char * argv[]){
+	char * end;
+	int option;
+
+	while ((option = getopt(argc, argv, "o:dq:n:z:")) != -1){
+		switch (option){
+		case 'o':
+			outputPath = optarg;
+			break;
+		case 'd':
+			dataOnly = true;
+			break;
+		case 'q':
+			quantum = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || quantum < 1)
+				printUsageExit();
+			break;
+		case 'n':
+			maxReferences = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0'
+			    || maxReferences < 1)
+				printUsageExit();
+			break;
+		case 'z':
+			pageSize = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || pageSize < 1
+			    || pageSize > MAX_PAGE_SIZE)
+				printUsageExit();
+			break;
+		default:
+			printUsageExit();
+		}
+	}
+
+	if (outputPath == NULL || optind == argc) printUsageExit();
+
+	// Numbers no more pages than int addresses can reach
+	if (((long) INT_MAX + 1) / pageSize < maxPages)
+		maxPages = ((long) INT_MAX + 1) / pageSize;
+}
+
+// Prints usage message on incorrect usage and exits
+static void printUsageExit(){
+	fprintf(stderr, "\nusage: \n\t%s [-d] [-q n] [-n n] [-z n] -o trace "
+		"file..."
+		"\n\nEach file holds Valgrind lackey --trace-mem output or "
+		"lines of R or W and a\nhex address, and becomes one process."
+#ifdef ZLIB
+		" Files may be compressed with gzip."
+#endif
+		"\n\noptions:\n"
+		"\t-o file\twrite the trace to file for replay with oss -p -T\n"
+		"\t-d\tskip instruction fetches\n"
+		"\t-q n\ttake n references from each file in turn (default "
+		"%d)\n"
+		"\t-n n\timport at most n references\n"
+		"\t-z n\tnumber pages of n bytes, the -z oss replays with "
+		"(default %d)\n",
+		exeName, IMPORT_QUANTUM, PAGE_SIZE);
+	exit(1);
+}
+
+// Opens an input file and starts numbering its pages from 0
+static void openSource(ImportSource * src, const char * path){
+	int slotBits;	// Log base 2 of the initial number of slots
+
+#ifdef ZLIB
+	if ((src->file = gzopen(path, "r")) == NULL)
+		perrorExit("Failed to open input trace");
+	gzbuffer(src->file, IMPORT_BUFFER_SIZE);
+#else
+	if ((src->file = open(path, O_RDONLY)) == -1)
+		perrorExit("Failed to open input trace");
+#endif
+
+	// Leaves room to end a last line that has no newline
+	src->buffer = importAlloc(IMPORT_BUFFER_SIZE + 1);
+	src->pos = src->end = src->buffer;
+	src->atEof = false;
+	src->done = false;
+
+	slotBits = 0;
+	while ((1 << slotBits) < IMPORT_INITIAL_SLOTS) slotBits++;
+	allocSlots(src, slotBits);
+
+	src->numPages = 0;
+	src->references = 0;
+	src->skipped = 0;
+	src->bytes = 0;
+}
+
+// Closes an input file and frees its buffer and page numbers
+static void closeSource(ImportSource * src){
+#ifdef ZLIB
+	gzclose(src->file);
+#else
+	close(src->file);
+#endif
+	free(src->buffer);
+	free(src->keys);
+	free(src->pageNums);
+	src->done = true;
+}
+
+// Gets the next reference of a file, returning false at the end of it
+static bool nextReference(ImportSource * src, unsigned long * address,
+			  RefType * type){
+	char * line;	// Start of the line
+	char * end;	// Newline ending the line
+
+	while ((line = nextLine(src, &end)) != NULL){
+		if (parseLine(src, line, end, address, type)){
+			src->references++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Returns the start of the next line and sets lineEnd to its newline, or
+// returns NULL at the end of the file
+static char * nextLine(ImportSource * src, char ** lineEnd){
+	char * line;	// Start of the line
+	char * newline;	// Newline ending the line
+
+	while ((newline = memchr(src->pos, '\n', src->end - src->pos))
+	       == NULL){
+		if (src->atEof){
+			if (src->pos == src->end) return NULL;
+
+			// Ends the last line
+			newline = src->end++;
+			*newline = '\n';
+			break;
+		}
+		refill(src);
+	}
+
+	line = src->pos;
+	*lineEnd = newline;
+	src->pos = newline + 1;
+	src->bytes += src->pos - line;
+
+	return line;
+}
+
+// Moves the unparsed part of a line to the front of the buffer and reads more
+static void refill(ImportSource * src){
+	size_t left = src->end - src->pos;	// Bytes of a partial line
+	long bytesRead;				// Bytes read or -1
+
+	if (left == IMPORT_BUFFER_SIZE)
+		perrorExit("Input trace has a line too long to parse");
+
+	memmove(src->buffer, src->pos, left);
+	src->pos = src->buffer;
+	src->end = src->buffer + left;
+
+#ifdef ZLIB
+	bytesRead = gzread(src->file, src->end, IMPORT_BUFFER_SIZE - left);
+#else
+	bytesRead = read(src->file, src->end, IMPORT_BUFFER_SIZE - left);
+#endif
+	if (bytesRead < 0)
+		perrorExit("Failed to read input trace");
+
+	src->end += bytesRead;
+	src->atEof = bytesRead == 0;
+}
+
+// Parses a line ending at end, returning true if it was a reference. Lackey
+// marks instruction fetches I, loads L, stores S, and modifies M, and other
+// lines, such as Valgrind's messages, are skipped.
+static bool parseLine(ImportSource * src, const char * pos, const char * end,
+		      unsigned long * address, RefType * type){
+	const char * digits;	// First hex digit of the address
+	unsigned long value = 0;// Value of the address
+
+	while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+	if (pos == end) return false;
+
+	switch (*pos++){
+	case 'I':
+		if (dataOnly) return false;
+		*type = READ_REFERENCE;
+		break;
+	case 'L':
+	case 'R':
+	case 'r':
+		*type = READ_REFERENCE;
+		break;
+	case 'S':
+	case 'M':
+	case 'W':
+	case 'w':
+		*type = WRITE_REFERENCE;
+		break;
+	default:
+		src->skipped++;
+		return false;
+	}
+
+	while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+	if (end - pos > 2 && pos[0] == '0' && (pos[1] == 'x' || pos[1] == 'X'))
+		pos += 2;
+
+	digits = pos;
+	while (pos < end && hexValues[(unsigned char) *pos] >= 0)
+		value = value << 4 | hexValues[(unsigned char) *pos++];
+
+	// Lackey follows the address with a comma and the size of the access
+	if (pos == digits || (pos < end && *pos != ',' && *pos != ' '
+			      && *pos != '\t' && *pos != '\r')){
+		src->skipped++;
+		return false;
+	}
+
+	*address = value;
+	return true;
+}
+
+// Returns the address in the dense address space of the file's process,
+// numbering the address's page if it has not been referenced before
+static int mapAddress(ImportSource * src, unsigned long address){
+	unsigned long key = address / pageSize + 1;	// Never 0
+	unsigned long mask = (1UL << src->slotBits) - 1;
+	unsigned long slot;
+	int pageNum;
+
+	// Probes linearly from a Fibonacci hash of the page
+	slot = (key * IMPORT_HASH_MULTIPLIER) >> (64 - src->slotBits);
+	while (src->keys[slot] != 0 && src->keys[slot] != key)
+		slot = (slot + 1) & mask;
+
+	if (src->keys[slot] == 0){
+		if (src->numPages == maxPages)
+			perrorExit("An input trace references more pages than "
+				   "addresses can hold");
+
+		src->keys[slot] = key;
+		src->pageNums[slot] = src->numPages++;
+	}
+	pageNum = src->pageNums[slot];
+
+	// Keeps the table at most half full
+	if ((unsigned long) src->numPages * 2 > mask + 1)
+		growSlots(src);
+
+	return pageNum * pageSize + address % pageSize;
+}
+
+// Allocates an empty table of 2^slotBits slots
+static void allocSlots(ImportSource * src, int slotBits){
+	src->slotBits = slotBits;
+	src->keys = importAlloc(sizeof(unsigned long) << slotBits);
+	src->pageNums = importAlloc(sizeof(int) << slotBits);
+	memset(src->keys, 0, sizeof(unsigned long) << slotBits);
+}
+
+// Doubles the number of slots, moving each numbered page to its new slot
+static void growSlots(ImportSource * src){
+	unsigned long * keys = src->keys;
+	int * pageNums = src->pageNums;
+	unsigned long numSlots = 1UL << src->slotBits;
+	unsigned long mask;
+	unsigned long slot;
+	unsigned long i;
+
+	allocSlots(src, src->slotBits + 1);
+	mask = (1UL << src->slotBits) - 1;
+
+	for (i = 0; i < numSlots; i++){
+		if (keys[i] == 0) continue;
+
+		slot = (keys[i] * IMPORT_HASH_MULTIPLIER)
+		       >> (64 - src->slotBits);
+		while (src->keys[slot] != 0) slot = (slot + 1) & mask;
+
+		src->keys[slot] = keys[i];
+		src->pageNums[slot] = pageNums[i];
+	}
+
+	free(keys);
+	free(pageNums);
+}
+
+// Sets the value of each hex digit and -1 for every other character
+static void initHexValues(){
+	int i;
+
+	for (i = 0; i < 256; i++) hexValues[i] = -1;
+	for (i = 0; i < 10; i++) hexValues['0' + i] = i;
+	for (i = 0; i < 6; i++){
+		hexValues['a' + i] = 10 + i;
+		hexValues['A' + i] = 10 + i;
+	}
+}
+
+// Allocates memory or exits with an error message
+static void * importAlloc(size_t size){
+	void * ptr;
+
+	if ((ptr = malloc(size)) == NULL)
+		perrorExit("Failed to allocate memory for import");
+
+	return ptr;
+}
@@ -0,0 +1,719 @@
+// trials.c was created by Mark Renard on 5/12/2020.
+//
+// This program runs oss many times with different seeds and summarizes the
+// results. Each trial runs oss with the options of its configuration, -s set
+// to a seed of its own, and the log sent to /dev/null. Trials run in
+// parallel, as many at once as there are processors by default, and each
+// runs in a new session and IPC namespace, so that the shared memory and
+// message queues of oss, which use fixed keys, are never shared between
+// trials. Users without the privilege to create IPC namespaces get them
+// inside user namespaces, and where neither can be created trials run one at
+// a time. The page fault rate, accesses per second, and effective access
+// time oss prints to stderr are summarized by their mean, standard
+// deviation, and confidence interval, and when two configurations are given
+// they are compared with Welch's t-test.
+//
+// Given -g options, trials instead sweeps a grid of oss parameters. Each -g
+// names a parameter and the values it takes, and every combination of
+// values is a configuration, run with the base options followed by -o
+// name=value for each parameter. The trials of every configuration are
+// scheduled together, use the same seeds so that differences between points
+// are not hidden by differences between workloads, and are summarized in a
+// CSV table on stdout with one row per configuration.
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "constants.h"
+#include "perrorExit.h"
+
+// Results oss reports that are summarized
+typedef enum measure {
+	FAULT_RATE,	// Page faults per memory access
+	ACCESS_RATE,	// Memory accesses per simulated second
+	EAT,		// Mean seconds per memory access
+	NUM_MEASURES
+} Measure;
+
+// Options of oss shared by the trials of a configuration
+typedef struct configuration {
+	char ** args;	// Options given on the command line
+	int numArgs;	// Length of args
+} Configuration;
+
+// A parameter of oss swept over a list of values
+typedef struct axis {
+	char * name;		// Name of the parameter, as -o takes it
+	char ** values;		// Values the parameter takes
+	int numValues;		// Length of values
+} Axis;
+
+// A run of oss and the results it reported
+typedef struct trial {
+	int config;			// Index of its configuration
+	unsigned int seed;		// Seed oss was given with -s
+	pid_t pid;			// Pid of oss while it runs, else 0
+	FILE * output;			// Temporary file holding oss's stderr
+	double values[NUM_MEASURES];	// Results of each measure
+} Trial;
+
+// Prototypes
+static void getTrialOptions(int argc, char * argv[]);
+static void addAxis(const char * arg);
+static void makeGrid(char ** base, int numBase);
+static int valueIndex(int config, int axis);
+static void printUsageExit();
+static void startTrial(Trial * trial);
+static bool canIsolateTrials();
+static bool isolateTrial();
+static bool writeProcFile(const char * path, const char * text);
+static void finishTrial(Trial * trial, int status);
+static void stopTrials();
+static void summarize(int config);
+static void compare();
+static void printTable();
+static void printStatistic(double value, bool defined);
+static void meanAndVariance(int config, Measure measure, double * mean,
+			    double * variance, int * n);
+static double tPValue(double t, double df);
+static double tCritical(double confidence, double df);
+static double incompleteBeta(double x, double a, double b);
+static double betaFraction(double x, double a, double b);
+static void * trialsAlloc(size_t size);
+
+// Constants
+static const char * MEASURE_NAMES[NUM_MEASURES] = {
+	"Page faults per access",
+	"Accesses per second",
+	"Effective access time (s)"
+};
+static const char * MEASURE_KEYS[NUM_MEASURES] = {
+	"pageFaultsPerMemoryAccess",
+	"memoryAccessesPerSecond",
+	"averageMemoryAccessSpeed"
+};
+
+// Static global variables
+static int numTrials = DEFAULT_TRIALS;		// Trials per configuration
+static int jobs = 0;				// Trials run at once
+static unsigned int baseSeed = TRIAL_BASE_SEED;	// Seed of the first trial
+static double confidence = DEFAULT_CONFIDENCE;	// Level of the intervals
+static Configuration * configs;			// Configurations run
+static int numConfigs = 0;			// Length of configs
+static Axis * axes = NULL;			// Parameters swept, if any
+static int numAxes = 0;				// Length of axes
+static Trial * trials = NULL;			// Every trial of every config
+
+int main(int argc, char * argv[]){
+	struct timespec start, stop;
+	int total;		// Trials of every configuration
+	int next = 0;		// Index of the next trial to start
+	int running = 0;	// Trials started but not finished
+	int status;		// Exit status of a finished trial
+	pid_t pid;
+	int i;
+
+	exeName = argv[0];	// Assigns exeName for perrorExit
+	signalGroup = false;	// Exits alone on errors, outside oss
+
+	getTrialOptions(argc, argv);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	// Assigns each trial its configuration and seed, repeating the seeds
+	// of the first configuration at each point of a sweep
+	total = numTrials * numConfigs;
+	trials = trialsAlloc(sizeof(Trial) * total);
+	for (i = 0; i < total; i++){
+		trials[i].config = i / numTrials;
+		trials[i].seed = baseSeed + (numAxes > 0 ? i % numTrials : i);
+		trials[i].pid = 0;
+	}
+
+	// Stops the trials still running whenever trials exits on an error
+	if (atexit(stopTrials) != 0)
+		perrorExit("Failed to register the cleanup of trials");
+
+	// Runs one trial at a time when trials cannot have IPC namespaces of
+	// their own, since the keys of trials run at once would collide
+	if (jobs > 1 && !canIsolateTrials()){
+		fprintf(stderr, "%s: Warning: cannot create IPC namespaces for "
+			"trials, running one at a time\n", exeName);
+		jobs = 1;
+	}
+
+	// Keeps jobs trials running until every one has finished
+	while (next < total || running > 0){
+		while (running < jobs && next < total){
+			startTrial(&trials[next++]);
+			running++;
+		}
+
+		if ((pid = wait(&status)) == -1)
+			perrorExit("Failed to wait for a trial");
+
+		for (i = 0; i < next && trials[i].pid != pid; i++);
+		if (i == next) continue;
+
+		finishTrial(&trials[i], status);
+		running--;
+	}
+
+	// Keeps the table of a sweep alone on stdout
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	fprintf(numAxes > 0 ? stderr : stdout,
+		"%d trials, %d at a time, in %.2fs\n\n", total, jobs,
+		(stop.tv_sec - start.tv_sec)
+		+ (stop.tv_nsec - start.tv_nsec) / 1e9);
+
+	if (numAxes > 0){
+		printTable();
+	} else {
+		for (i = 0; i < numConfigs; i++)
+			summarize(i);
+		if (numConfigs == 2)
+			compare();
+	}
+
+	free(trials);
+	trials = NULL;
+	return 0;
+}
+
+// Sets the options and configurations from the command line or exits with a
+// usage message
+static void getTrialOptions(int argc, char * argv[]){
+	char * end;
+	int option;
+	int i;
+
+	while ((option = getopt(argc, argv, "+n:j:s:c:g:")) != -1){
+		switch (option){
+		case 'n':
+			numTrials = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || numTrials < 1)
+				printUsageExit();
+			break;
+		case 'j':
+			jobs = strtol(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0' || jobs < 1)
+				printUsageExit();
+			break;
+		case 's':
+			baseSeed = strtoul(optarg, &end, 10);
+			if (*optarg == '\0' || *end != '\0')
+				printUsageExit();
+			break;
+		case 'c':
+			confidence = strtod(optarg, &end);
+			if (*optarg == '\0' || *end != '\0'
+			    || confidence <= 0 || confidence >= 1)
+				printUsageExit();
+			break;
+		case 'g':
+			addAxis(optarg);
+			break;
+		default:
+			printUsageExit();
+		}
+	}
+
+	// Makes a configuration of each point of a sweep from the base options
+	if (numAxes > 0){
+		for (i = optind; i < argc; i++)
+			if (strcmp(argv[i], "--") == 0) printUsageExit();
+		makeGrid(&argv[optind], argc - optind);
+	}
+
+	// Splits the remaining arguments into configurations at each --, which
+	// need at least two trials each to be summarized
+	else {
+		if (numTrials < 2) printUsageExit();
+
+		configs = trialsAlloc(sizeof(Configuration) * MAX_CONFIGS);
+		for (i = optind; i <= argc; i++){
+			if (i < argc && strcmp(argv[i], "--") != 0) continue;
+
+			if (numConfigs == MAX_CONFIGS || i == optind)
+				printUsageExit();
+			configs[numConfigs].args = &argv[optind];
+			configs[numConfigs++].numArgs = i - optind;
+			optind = i + 1;
+		}
+	}
+
+	if (jobs == 0 && (jobs = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+		jobs = 1;
+}
+
+// Adds a parameter to the sweep from an argument of the form
+// name=value,value,... or exits with a usage message
+static void addAxis(const char * arg){
+	Axis * axis;
+	char * value;	// The next value in the list
+	char * comma;	// The comma after it, if any
+
+	axes = realloc(axes, sizeof(Axis) * (numAxes + 1));
+	if (axes == NULL) perrorExit("Failed to allocate memory for trials");
+	axis = &axes[numAxes++];
+
+	axis->name = strdup(arg);
+	if (axis->name == NULL)
+		perrorExit("Failed to allocate memory for trials");
+	if ((value = strchr(axis->name, '=')) == NULL || value == axis->name)
+		printUsageExit();
+	*value++ = '\0';
+
+	// Splits the values at each comma
+	axis->values = trialsAlloc(sizeof(char *) * (strlen(value) + 1));
+	axis->numValues = 0;
+	do {
+		if ((comma = strchr(value, ',')) != NULL) *comma = '\0';
+		if (*value == '\0') printUsageExit();
+		axis->values[axis->numValues++] = value;
+		value = comma + 1;
+	} while (comma != NULL);
+}
+
+// Makes a configuration of the base options followed by -o name=value for
+// each parameter swept, for every combination of their values
+static void makeGrid(char ** base, int numBase){
+	Configuration * config;
+	const char * value;	// Value of a parameter at a point
+	int i, j;
+
+	numConfigs = 1;
+	for (j = 0; j < numAxes; j++){
+		if (numConfigs > INT_MAX / axes[j].numValues / numTrials)
+			printUsageExit();
+		numConfigs *= axes[j].numValues;
+	}
+
+	configs = trialsAlloc(sizeof(Configuration) * numConfigs);
+	for (i = 0; i < numConfigs; i++){
+		config = &configs[i];
+		config->numArgs = numBase + 2 * numAxes;
+		config->args = trialsAlloc(sizeof(char *) * config->numArgs);
+		memcpy(config->args, base, sizeof(char *) * numBase);
+
+		for (j = 0; j < numAxes; j++){
+			value = axes[j].values[valueIndex(i, j)];
+			config->args[numBase + 2 * j] = "-o";
+			config->args[numBase + 2 * j + 1] = trialsAlloc(
+				strlen(axes[j].name) + strlen(value) + 2);
+			sprintf(config->args[numBase + 2 * j + 1], "%s=%s",
+				axes[j].name, value);
+		}
+	}
+}
+
+// Returns the index of the value a parameter takes in a configuration of a
+// sweep, with the last parameter changing fastest
+static int valueIndex(int config, int axis){
+	int j;
+
+	for (j = numAxes - 1; j > axis; j--)
+		config /= axes[j].numValues;
+
+	return config % axes[axis].numValues;
+}
+
+// Prints usage message on incorrect usage and exits
+static void printUsageExit(){
+	fprintf(stderr, "\nusage: \n\t%s [-n n] [-j n] [-s n] [-c level] "
+		"-- options [-- options]\n\t%s [-n n] [-j n] [-s n] "
+		"[-c level] -g name=values... [-- options]\n\nRuns oss n "
+		"times with each set of options and a different seed each "
+		"time,\nthen summarizes the page fault rate, accesses per "
+		"second, and effective\naccess time of each set. Two sets "
+		"are compared with Welch's t-test.\nEach -g sweeps a "
+		"parameter of oss over a comma-separated list of values,\n"
+		"running every combination of values with the options given "
+		"and printing\na CSV table with a row for each.\n\n"
+		"options:\n"
+		"\t-n n\trun n trials of each set of options (default %d)\n"
+		"\t-j n\trun n trials at once (default: one per processor)\n"
+		"\t-s n\tseed the first trial with n, the next n + 1, and so "
+		"on (default %d)\n"
+		"\t-c level\treport confidence intervals at level (default "
+		"%g)\n"
+		"\t-g name=value,...\tsweep the oss parameter name over the "
+		"values\n\nexamples:\n\t%s -n 100 -- -m 0 -p -- -m 1 -p\n"
+		"\t%s -n 20 -g frames=64,128,256 -g policy=clock,lru -- "
+		"-m 1 -p\n",
+		exeName, exeName, DEFAULT_TRIALS, TRIAL_BASE_SEED,
+		DEFAULT_CONFIDENCE, exeName, exeName);
+	exit(1);
+}
+
+// Forks and executes oss in a new session and IPC namespace, with its
+// stderr written to a temporary file
+static void startTrial(Trial * trial){
+	const Configuration * config = &configs[trial->config];
+	char seed[BUFF_SZ];	// The trial's seed as a string
+	char ** args;		// Arguments oss is executed with
+	int devNull;		// Descriptor of /dev/null
+	int i;
+
+	if ((trial->output = tmpfile()) == NULL)
+		perrorExit("Failed to create a file for trial output");
+
+	// Sends the log to /dev/null unless the options name a file, and
+	// gives the trial's seed after the options so that it is used
+	snprintf(seed, BUFF_SZ, "%u", trial->seed);
+	args = trialsAlloc(sizeof(char *) * (config->numArgs + 6));
+	args[0] = OSS_PATH;
+	args[1] = "-L";
+	args[2] = "/dev/null";
+	for (i = 0; i < config->numArgs; i++)
+		args[i + 3] = config->args[i];
+	args[i + 3] = "-s";
+	args[i + 4] = seed;
+	args[i + 5] = NULL;
+
+	if ((trial->pid = fork()) == -1)
+		perrorExit("Failed to fork a trial");
+
+	if (trial->pid == 0){
+
+		// Keeps oss's kill(0, SIGQUIT) and IPC keys to this trial,
+		// though a trial run alone can share the host's keys
+		setsid();
+		if (!isolateTrial() && jobs > 1){
+			perror("Failed to create an IPC namespace for a trial");
+			_exit(1);
+		}
+
+		if ((devNull = open("/dev/null", O_WRONLY)) == -1
+		    || dup2(devNull, STDOUT_FILENO) == -1
+		    || dup2(fileno(trial->output), STDERR_FILENO) == -1){
+			perror("Failed to redirect trial output");
+			_exit(1);
+		}
+
+		execv(OSS_PATH, args);
+		perror("Failed to execute " OSS_PATH);
+		_exit(1);
+	}
+
+	free(args);
+}
+
+// Returns whether trials can be given IPC namespaces, by isolating a child
+// that exits at once
+static bool canIsolateTrials(){
+	int status;	// Exit status of the child
+	pid_t pid;
+
+	if ((pid = fork()) == -1)
+		perrorExit("Failed to fork a trial");
+	if (pid == 0) _exit(isolateTrial() ? 0 : 1);
+
+	if (waitpid(pid, &status, 0) == -1)
+		perrorExit("Failed to wait for a trial");
+
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Moves the calling process into an IPC namespace of its own and returns
+// whether it succeeded. Without the privilege to create one, the namespace is
+// created with a user namespace that maps the caller's ids to themselves
+static bool isolateTrial(){
+	char map[BUFF_SZ];	// Line of a uid or gid map
+	uid_t uid = getuid();	// Ids outside the user namespace
+	gid_t gid = getgid();
+
+	if (unshare(CLONE_NEWIPC) == 0) return true;
+	if (unshare(CLONE_NEWUSER | CLONE_NEWIPC) == -1) return false;
+
+	snprintf(map, BUFF_SZ, "%u %u 1\n", uid, uid);
+	if (!writeProcFile("/proc/self/uid_map", map)) return false;
+
+	snprintf(map, BUFF_SZ, "%u %u 1\n", gid, gid);
+	return writeProcFile("/proc/self/setgroups", "deny\n")
+	       && writeProcFile("/proc/self/gid_map", map);
+}
+
+// Writes text to a file under /proc and returns whether it succeeded
+static bool writeProcFile(const char * path, const char * text){
+	ssize_t length = strlen(text);
+	bool written;
+	int fd;
+
+	if ((fd = open(path, O_WRONLY)) == -1) return false;
+	written = write(fd, text, length) == length;
+
+	return close(fd) == 0 && written;
+}
+
+// Reads the results of a trial that exited, or stops every trial and exits
+// if it failed or reported no results
+static void finishTrial(Trial * trial, int status){
+	char line[BUFF_SZ];	// A line oss printed to stderr
+	char key[BUFF_SZ];	// Name of the value on the line
+	double value;		// Value on the line
+	bool found[NUM_MEASURES] = {false};	// Whether each was reported
+	bool succeeded;				// Whether the trial succeeded
+	int j;
+
+	trial->pid = 0;
+	rewind(trial->output);
+	while (fgets(line, BUFF_SZ, trial->output) != NULL){
+		if (sscanf(line, "%99[^:]: %lf", key, &value) != 2) continue;
+
+		for (j = 0; j < NUM_MEASURES; j++)
+			if (strcmp(key, MEASURE_KEYS[j]) == 0){
+				trial->values[j] = value;
+				found[j] = true;
+			}
+	}
+	fclose(trial->output);
+
+	succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	for (j = 0; j < NUM_MEASURES; j++)
+		succeeded = succeeded && found[j];
+
+	if (!succeeded){
+		fprintf(stderr, "%s: trial with seed %u failed with options:",
+			exeName, trial->seed);
+		for (j = 0; j < configs[trial->config].numArgs; j++)
+			fprintf(stderr, " %s", configs[trial->config].args[j]);
+		fprintf(stderr, "\n");
+		exit(1);
+	}
+}
+
+// Interrupts the trials still running, which oss cleans up after
+static void stopTrials(){
+	int i;
+
+	if (trials == NULL) return;
+
+	for (i = 0; i < numTrials * numConfigs; i++)
+		if (trials[i].pid > 0)
+			kill(-trials[i].pid, SIGINT);
+
+	while (wait(NULL) != -1);
+}
+
+// Prints the mean, standard deviation, and confidence interval of each
+// measure of a configuration
+static void summarize(int config){
+	double mean, variance;	// Sample mean and variance
+	double margin;		// Half the width of the interval
+	int n;			// Trials of the configuration
+	int i, j;
+
+	printf("%c:", 'A' + config);
+	for (i = 0; i < configs[config].numArgs; i++)
+		printf(" %s", configs[config].args[i]);
+	printf("\n");
+
+	for (j = 0; j < NUM_MEASURES; j++){
+		meanAndVariance(config, j, &mean, &variance, &n);
+		margin = tCritical(confidence, n - 1) * sqrt(variance / n);
+
+		printf("  %-27s mean %-12.6g sd %-12.6g %g%% CI [%.6g, %.6g]\n",
+		       MEASURE_NAMES[j], mean, sqrt(variance),
+		       confidence * 100, mean - margin, mean + margin);
+	}
+	printf("\n");
+}
+
+// Prints Welch's t-test of the difference in each measure between the two
+// configurations
+static void compare(){
+	double meanA, varianceA, meanB, varianceB;
+	double errorA, errorB;	// Squared standard errors of the means
+	double t, df;		// The t statistic and its degrees of freedom
+	double p;		// Two-sided p-value
+	int nA, nB;
+	int j;
+
+	printf("A - B, Welch's t-test:\n");
+	for (j = 0; j < NUM_MEASURES; j++){
+		meanAndVariance(0, j, &meanA, &varianceA, &nA);
+		meanAndVariance(1, j, &meanB, &varianceB, &nB);
+		errorA = varianceA / nA;
+		errorB = varianceB / nB;
+
+		// Leaves measures that never vary equal or certainly unequal
+		if (errorA + errorB == 0){
+			printf("  %-27s difference %-12.6g p %g\n",
+			       MEASURE_NAMES[j], meanA - meanB,
+			       meanA == meanB ? 1.0 : 0.0);
+			continue;
+		}
+
+		t = (meanA - meanB) / sqrt(errorA + errorB);
+		df = (errorA + errorB) * (errorA + errorB)
+		     / (errorA * errorA / (nA - 1)
+			+ errorB * errorB / (nB - 1));
+		p = tPValue(t, df);
+
+		printf("  %-27s difference %-12.6g t %-9.4g df %-7.1f p %.4g\n",
+		       MEASURE_NAMES[j], meanA - meanB, t, df, p);
+	}
+}
+
+// Prints the parameters of each configuration of a sweep, its trials, and
+// the mean, standard deviation, and confidence interval of each measure as
+// a row of CSV, with NA for statistics one trial cannot give
+static void printTable(){
+	double mean, variance;	// Sample mean and variance
+	double margin;		// Half the width of the interval
+	int n;			// Trials of the configuration
+	int i, j;
+
+	for (j = 0; j < numAxes; j++)
+		printf("%s,", axes[j].name);
+	printf("trials");
+	for (j = 0; j < NUM_MEASURES; j++)
+		printf(",%s_mean,%s_sd,%s_ci_low,%s_ci_high", MEASURE_KEYS[j],
+		       MEASURE_KEYS[j], MEASURE_KEYS[j], MEASURE_KEYS[j]);
+	printf("\n");
+
+	for (i = 0; i < numConfigs; i++){
+		for (j = 0; j < numAxes; j++)
+			printf("%s,", axes[j].values[valueIndex(i, j)]);
+		printf("%d", numTrials);
+
+		for (j = 0; j < NUM_MEASURES; j++){
+			meanAndVariance(i, j, &mean, &variance, &n);
+			margin = n > 1 ? tCritical(confidence, n - 1)
+					 * sqrt(variance / n) : 0;
+
+			printStatistic(mean, true);
+			printStatistic(sqrt(variance), n > 1);
+			printStatistic(mean - margin, n > 1);
+			printStatistic(mean + margin, n > 1);
+		}
+		printf("\n");
+	}
+}
+
+// Prints a field of the table, or NA if the value is undefined
+static void printStatistic(double value, bool defined){
+	if (defined)
+		printf(",%.6g", value);
+	else
+		printf(",NA");
+}
+
+// Computes the sample mean and variance of a measure over the trials of a
+// configuration
+static void meanAndVariance(int config, Measure measure, double * mean,
+			    double * variance, int * n){
+	double sum = 0, squares = 0;	// Sums of values and squared deviations
+	const Trial * first = &trials[config * numTrials];
+	int i;
+
+	*n = numTrials;
+	for (i = 0; i < numTrials; i++)
+		sum += first[i].values[measure];
+	*mean = sum / numTrials;
+
+	for (i = 0; i < numTrials; i++)
+		squares += (first[i].values[measure] - *mean)
+			   * (first[i].values[measure] - *mean);
+	*variance = numTrials > 1 ? squares / (numTrials - 1) : 0;
+}
+
+// Returns the probability that |T| >= |t| for Student's t with df degrees of
+// freedom
+static double tPValue(double t, double df){
+	return incompleteBeta(df / (df + t * t), df / 2, 0.5);
+}
+
+// Returns the t with a two-sided p-value of 1 - confidence, by bisection
+static double tCritical(double confidence, double df){
+	double low = 0, high = T_CRITICAL_MAX;
+	int i;
+
+	for (i = 0; i < T_CRITICAL_STEPS; i++){
+		if (tPValue((low + high) / 2, df) > 1 - confidence)
+			low = (low + high) / 2;
+		else
+			high = (low + high) / 2;
+	}
+
+	return (low + high) / 2;
+}
+
+// Returns the regularized incomplete beta function I_x(a, b)
+static double incompleteBeta(double x, double a, double b){
+	double front;	// Factor outside the continued fraction
+
+	if (x <= 0) return 0;
+	if (x >= 1) return 1;
+
+	front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x)
+		    + b * log(1 - x));
+
+	// Uses the continued fraction where it converges quickly
+	if (x < (a + 1) / (a + b + 2))
+		return front * betaFraction(x, a, b) / a;
+	return 1 - front * betaFraction(1 - x, b, a) / b;
+}
+
+// Evaluates the continued fraction of the incomplete beta function with
+// Lentz's method
+static double betaFraction(double x, double a, double b){
+	double c = 1, d, f;	// Terms of Lentz's method
+	double coefficient;	// Numerator of the next term
+	double delta;		// Factor the fraction changed by
+	int m;
+
+	d = 1 - (a + b) * x / (a + 1);
+	if (fabs(d) < BETA_TINY) d = BETA_TINY;
+	d = 1 / d;
+	f = d;
+
+	for (m = 1; m <= BETA_MAX_TERMS; m++){
+
+		// Applies the even term, then the odd term
+		coefficient = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+		d = 1 + coefficient * d;
+		if (fabs(d) < BETA_TINY) d = BETA_TINY;
+		c = 1 + coefficient / c;
+		if (fabs(c) < BETA_TINY) c = BETA_TINY;
+		d = 1 / d;
+		f *= d * c;
+
+		coefficient = -(a + m) * (a + b + m) * x
+			      / ((a + 2 * m) * (a + 2 * m + 1));
+		d = 1 + coefficient * d;
+		if (fabs(d) < BETA_TINY) d = BETA_TINY;
+		c = 1 + coefficient / c;
+		if (fabs(c) < BETA_TINY) c = BETA_TINY;
+		d = 1 / d;
+		delta = d * c;
+		f *= delta;
+
+		if (fabs(delta - 1) < BETA_EPSILON) break;
+	}
+
+	return f;
+}
+
+// Allocates memory or exits with an error message
+static void * trialsAlloc(size_t size){
+	void * ptr;
+
+	if ((ptr = malloc(size)) == NULL)
+		perrorExit("Failed to allocate memory for trials");
+
+	return ptr;
+}
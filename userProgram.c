@@ -18,22 +18,21 @@
 #include "protectedClock.h"
 #include "qMsg.h"
 #include "randomGen.h"
+#include "referenceGen.h"
+#include "refRing.h"
 #include "sharedMemory.h"
 
 // Prototypes
 static void simulateMemoryReferencing();
-static int getAddress();
-static int weightedAddressSelection(int maxPageNum);
 static void makeReadReference(int address);
 static void makeWriteReference(int address);
+static void addRequest(MsgOp op, int address);
+static void sendBatch();
+static void waitForReply();
 static void signalTermination();
 
 // Constants
-static const Clock MIN_REF_INTERVAL = {MIN_REF_INTERVAL_SEC, 
-				       MIN_REF_INTERVAL_NS};
-static const Clock MAX_REF_INTERVAL = {MAX_REF_INTERVAL_SEC, 
-				       MAX_REF_INTERVAL_NS};
-static const Clock CLOCK_UPDATE = {CLOCK_UPDATE_SEC, CLOCK_UPDATE_NS};
+static const Time CLOCK_UPDATE = TIME(CLOCK_UPDATE_SEC, CLOCK_UPDATE_NS);
 
 // Static global variables
 static char * shm;                              // Pointer to shared memory
@@ -41,9 +40,14 @@ static ProtectedClock * systemClock;            // Shared memory system clock
 static FrameDescriptor * frameTable;            // Shared memory frame table
 static PCB * pcbs;                              // Shared process control blocks
 static double * weights;
+static Doorbell * doorbell;                     // Rung to wake oss
+static RefRing * ring;                          // Ring owned by this process
 
 static int simPid;	// Logical pid of the process
 static int weighted;	// Whether the random address selection is weighted
+static int useRing;	// Whether requests are passed through the ring
+static int batchSize;	// Number of references sent in each batch
+static RefBatch batch;	// References made but not yet sent
 static int requestMqId; // Id of message queue for resource requests & release
 static int replyMqId;   // Id of message queue for replies from oss
 
@@ -51,17 +55,26 @@ int main(int argc, char * argv[]){
 	exeName = argv[0];		// Sets exeName for perrorExit
 	simPid = atoi(argv[1]);		// Gets process's logical pid
 	weighted = atoi(argv[2]);	// Gets flag for address weighting
+	useRing = atoi(argv[3]);	// Gets flag for ring transport
+	batchSize = atoi(argv[4]);	// Gets number of references per batch
 
 	// Seeds pseudorandom number generator
 	srand(time(NULL) + BASE_SEED + simPid);
 
 	// Attaches to shared memory and gets pointers
-	getSharedMemoryPointers(&shm, &systemClock, &frameTable, &pcbs, 
-				&weights, 0);
-
-	// Gets message queues
-        requestMqId = getMessageQueue(REQUEST_MQ_KEY, MQ_PERMS);
-        replyMqId = getMessageQueue(REPLY_MQ_KEY, MQ_PERMS);
+	ShmConfig * config;
+	PageTableArena * pageTables;
+	RefRing * rings;
+	getSharedMemoryPointers(&shm, &config, &systemClock, &frameTable, 
+				&pcbs, &pageTables, &weights, &doorbell, &rings,
+				NULL);
+	ring = &rings[simPid];
+
+	// Gets message queues unless requests are passed through the ring
+	if (!useRing){
+		requestMqId = getMessageQueue(REQUEST_MQ_KEY, MQ_PERMS);
+		replyMqId = getMessageQueue(REPLY_MQ_KEY, MQ_PERMS);
+	}
 
 	simulateMemoryReferencing();
 
@@ -74,102 +87,104 @@ int main(int argc, char * argv[]){
 
 // Repeatedly sents requests for memory references to oss
 static void simulateMemoryReferencing(){
-	Clock now = {0, 0};		// Storage for the currnet time
-	Clock referenceTime = {0, 0};	// Time at which to make a reference
-	int maxReferences; 		// References before termination chance
-	int numReferences = 0;		// References made since reset
+	ReferenceGen gen;	// Progress toward terminating
+	Time now;		// Storage for the current time
+	int address;		// Address of the next reference
+	RefType type;		// Type of the next reference
 
-	// Randomly determines number of references (900 to 1100 by default)
-	maxReferences = randInt(MIN_REFERENCES, MAX_REFERENCES);
+	initReferenceGen(&gen);
 
 	// Repeatedly makes read or write references and terminates
-	while (numReferences < maxReferences \
-	       || !randBinary(TERMINATION_PROBABILITY)) {
+	while (referenceGenContinues(&gen)) {
 
 		now = getPTime(systemClock);
 	
-		// Makes a reference at or after reference time
-		if (clockCompare(now, referenceTime) >= 0){
-
-			// Updates numReferences
-			numReferences = (numReferences + 1) \
-					% (maxReferences + 1);
-
-			// Updates reference time
-			copyTime(&referenceTime, now);
-			incrementClock(&referenceTime, 
-					randomTime(MIN_REF_INTERVAL, 
-						   MAX_REF_INTERVAL));
-
-			// Makes read or write reference 
-			if (randBinary(READ_PROBABILITY)){
-				makeReadReference(getAddress());
-			} else {
-				makeWriteReference(getAddress());
-			}
-
-			// Increments the protected system clock
-			incrementPClock(systemClock, CLOCK_UPDATE);
-
-			// Waits for reference to finish
-			waitForMessage(replyMqId, NULL, simPid + 1);
+		// Waits for reference time
+		while (now < gen.referenceTime)
+			now = getPTime(systemClock);
+
+		// Makes read or write reference 
+		nextReference(&gen, now, pcbs[simPid].lengthRegister, weights,
+			      weighted, &address, &type);
+		if (type == READ_REFERENCE){
+			makeReadReference(address);
+		} else {
+			makeWriteReference(address);
+		}
+
+		// Increments the protected system clock
+		incrementPClock(systemClock, CLOCK_UPDATE);
+
+		// Sends the batch and waits for it to finish once full
+		if (batch.count == batchSize){
+			sendBatch();
+			waitForReply();
 		}
 	}
+
+	// Sends references remaining in a partial batch
+	if (batch.count > 0){
+		sendBatch();
+		waitForReply();
+	}
 }
 
 // Sends a request to oss to read from memory at a logical address
 static void makeReadReference(int address){
 
-	char addr[BUFF_SZ];
-	sprintf(addr, "%d", address);
-
-//	fprintf(stderr, "\n\t\tP%d READING %s\n\n", simPid, addr);
+//	fprintf(stderr, "\n\t\tP%d READING %d\n\n", simPid, address);
 
-	sendMessage(requestMqId, addr, simPid + 1);
+	addRequest(READ_MSG, address);
 }
 
 // Sends a request to oss to write to memory at a logical address
 static void makeWriteReference(int address){
-	char addr[BUFF_SZ];
-	sprintf(addr, "%d", ~address);
 
-//	fprintf(stderr, "\n\t\tP%d WRITING %s\n\n", simPid, addr);
+//	fprintf(stderr, "\n\t\tP%d WRITING %d\n\n", simPid, address);
 
-	sendMessage(requestMqId, addr, simPid + 1);
+	addRequest(WRITE_MSG, address);
 }
 
-// Returns a reference to an address in memory allocated to the process
-static int getAddress(){
-	int maxPageNum = pcbs[simPid].lengthRegister - 1;
+// Adds a request to the batch of requests to be sent
+static void addRequest(MsgOp op, int address){
+	static unsigned int seq = 0;		// Sequence number of last request
+	RefMsg * msg = &batch.msgs[batch.count++];	// The request to add
 
-	if (weighted)
-		return weightedAddressSelection(maxPageNum);
-	else
-		return randInt(0, (maxPageNum + 1) * PAGE_SIZE - 1);
+	msg->op = op;
+	msg->address = address;
+	msg->seq = ++seq;
+	msg->sent = getPTime(systemClock);
 }
 
-// Returns an address in page n with probability proportional to 1/n
-static int weightedAddressSelection(int maxPageNum){
-	double maxVal = weights[maxPageNum];
-	double val = randDouble(0, maxVal);
+// Sends the batch through the ring or the request message queue and empties it
+static void sendBatch(){
+	if (useRing)
+		ringPush(ring, &batch);
+	else
+		sendMessage(requestMqId, &batch, simPid + 1);
 
-	// Selects a random page number using the array of weights
-	int pageNum;
-	for (pageNum = 0; pageNum < maxPageNum; pageNum++){
-		if (weights[pageNum] > val) break;
-	}
+	// Wakes oss if it is waiting for requests
+	ringDoorbell(doorbell);
 
-	// Returns a random address in the selected page
-	return pageNum * PAGE_SIZE + randInt(0, PAGE_SIZE - 1);
+	batch.count = 0;
+}
+
+// Blocks until oss replies through the ring or the reply message queue
+static void waitForReply(){
+	static unsigned int repliesSeen = 0;	// Replies already received
+
+	if (useRing)
+		ringWaitForReply(ring, &repliesSeen);
+	else
+		waitForMessage(replyMqId, NULL, simPid + 1);
 }
 
 // Sends a message to oss indicating that the process is terminating
 static void signalTermination(){
-	char msgBuff[BUFF_SZ];
-	sprintf(msgBuff, "%d", TERMINATE);
 
 //	fprintf(stderr, "\n\t\tP%d TERMINATING\n\n", simPid);
 
-	sendMessage(requestMqId, msgBuff, simPid + 1);
+	addRequest(TERMINATE_MSG, 0);
+	sendBatch();
 }
 